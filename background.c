@@ -0,0 +1,84 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * launchBackground - Starts a command without waiting for it.
+ * @info: The parameter & return info struct.
+ * @av: The argument vector from main().
+ * @n: The node of the job.
+ *
+ * Description: Simple external commands are spawned directly, builtins
+ * run in a forked child, and pipelines, lists and groups are driven by a
+ * forked copy of the shell so that every process can still be reaped.
+ *
+ * Return: The pid of the job, or -1 if it could not be started.
+ */
+pid_t launchBackground(shell_info *info, char **av, int n)
+{
+    ast_node_t *node = info->ast + n;
+    builtin_table *builtin;
+    char *path;
+    pid_t pid;
+
+    if (node->type != AST_CMD)
+        return (forkNode(info, av, n, -1, -1));
+
+    info->tok = node->tok;
+    info->ntok = node->ntok;
+    setInfo(info, av);
+    if (prepareRedirections(info) == -1 || !info->argc)
+        return (-1);
+    builtin = getBuiltin(info->argv[0]);
+    if (builtin)
+        return (forkBuiltinStage(info, builtin, -1, -1));
+    path = resolveCmd(info, info->argv[0]);
+    if (!path && isCmd(info, info->argv[0]))
+        path = info->argv[0];
+    if (!path)
+        return (info->status = 127, print_error(info, "not found\n"), -1);
+    pid = spawnProcess(info, path, info->argv, NULL);
+    if (pid == -1)
+    {
+        info->status = errno == EACCES ? 126 : 127;
+        print_error(info, errno == EACCES ? "Permission denied\n" :
+                "not found\n");
+    }
+    return (pid);
+}
+
+/**
+ * runBackground - Runs a command terminated by '&' as a background job.
+ * @info: The parameter & return info struct.
+ * @av: The argument vector from main().
+ * @n: The node of the job.
+ *
+ * Return: 0 if the job was started, the failure status otherwise.
+ */
+int runBackground(shell_info *info, char **av, int n)
+{
+    char *cmd;
+    job_t *job;
+    pid_t pid;
+
+    info->fname = av[0];
+    cmd = commandText(info, info->ast[n].tok, info->ast[n].ntok);
+    pid = launchBackground(info, av, n);
+    freeArgv(info);
+    freeRedirections(info);
+    if (pid == -1)
+        return (free(cmd), info->status);
+
+    job = addJob(info, pid, cmd);
+    free(cmd);
+    if (job && interactive(info))
+    {
+        _putchar('[');
+        _puts(convert_number(job->id, 10, 0));
+        _puts("] ");
+        _puts(convert_number(pid, 10, 0));
+        _putchar('\n');
+    }
+    info->last_bg_pid = pid;
+    info->pipecount = 0;
+    return (info->status = 0);
+}
@@ -0,0 +1,127 @@
+#include "bench.h"
+
+/**
+ * printStamp - Prints the time of the monotonic clock, in nanoseconds.
+ *
+ * Description: This is what "bench --stamp" does. Scripts run it as
+ * their external command, so the gap between two stamps is the time
+ * the shell took to launch and reap one command and go on to the next.
+ *
+ * Return: 0 on success, 1 on failure.
+ */
+int printStamp(void)
+{
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), "%ld\n", nowNs());
+
+    return (write(STDOUT_FILENO, buf, len) != len);
+}
+
+/**
+ * removeEntry - Removes one entry of the scratch directory, for nftw().
+ * @path: The entry.
+ * @st: Unused.
+ * @flag: Unused.
+ * @ftw: Unused.
+ *
+ * Return: 0, so that the walk goes on whatever happens.
+ */
+int removeEntry(const char *path, const struct stat *st, int flag,
+        struct FTW *ftw)
+{
+    (void)st;
+    (void)flag;
+    (void)ftw;
+    remove(path);
+    return (0);
+}
+
+/**
+ * removeTree - Removes a directory and everything in it.
+ * @path: The directory.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int removeTree(char *path)
+{
+    return (nftw(path, removeEntry, 16, FTW_DEPTH | FTW_PHYS));
+}
+
+/**
+ * putLine - Writes a line of a script, padded with spaces.
+ * @f: The script.
+ * @line: The line, without its newline.
+ *
+ * Description: The baseline reads scripts 1024 bytes at a time and
+ * mangles a line that spans two reads, so every line is padded to a
+ * power of two no larger than 1024 and none of them does.
+ *
+ * Return: 0 on success, -1 if the line is too long or cannot be written.
+ */
+int putLine(FILE *f, char *line)
+{
+    int len = strlen(line) + 1, size = 1;
+
+    while (size < len)
+        size *= 2;
+    if (size > BENCH_BLOCK)
+        return (-1);
+    return (fprintf(f, "%-*s\n", size - 1, line) == size ? 0 : -1);
+}
+
+/**
+ * main - Times the shell under test against a baseline shell.
+ * @ac: arg count
+ * @av: "bench [-n runs] baseline-shell shell [case...]"; without cases
+ *      all of them run. "bench --stamp" and "bench --reads" are what
+ *      the scripts run.
+ *
+ * Return: 0 on success, 1 if a case failed, 2 on usage errors.
+ */
+int main(int ac, char **av)
+{
+    bench_case_t cases[] = {
+        {"spawn", spawnCase},
+        {"zygote", zygoteCase},
+        {"lexer", lexerCase},
+        {"reader", readerCase},
+        {"pipe", pipeCase},
+        {NULL, NULL}
+    };
+    bench_t b;
+    int i = 1, j, k, ret = 0;
+
+    if (ac == 2 && !strcmp(av[1], "--stamp"))
+        return (printStamp());
+    if (ac == 2 && !strcmp(av[1], "--reads"))
+        return (printReads());
+    memset(&b, 0, sizeof(b));
+    b.runs = BENCH_RUNS;
+    if (ac > 2 && !strcmp(av[1], "-n"))
+        b.runs = atoi(av[2]), i = 3;
+    if (ac - i < 2 || b.runs < 1 || !realpath(av[0], b.self))
+    {
+        fprintf(stderr, "usage: %s [-n runs] baseline-shell shell "
+                "[case...]\n", av[0]);
+        return (2);
+    }
+    b.shells[0] = av[i++];
+    b.shells[1] = av[i++];
+    strcpy(b.dir, "/tmp/hsh-bench.XXXXXX");
+    if (!mkdtemp(b.dir))
+        return (perror("mkdtemp"), 1);
+    snprintf(b.home, sizeof(b.home), "%s/home", b.dir);
+    for (j = 0; cases[j].name; j++)
+    {
+        for (k = i; k < ac && strcmp(av[k], cases[j].name); k++)
+            ;
+        if (k == ac && i < ac)
+            continue;
+        printf("%s\n", cases[j].name);
+        fflush(stdout);
+        if (cases[j].run(&b) == -1)
+            ret = 1;
+    }
+    removeTree(b.dir);
+    return (ret);
+}
@@ -0,0 +1,112 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <limits.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/* entries the history is filled with, HISTORY_MAX of the shell */
+#define BENCH_HISTORY	4096
+
+/* history file of the shell, in its HOME */
+#define BENCH_HISTFILE	".shell_history"
+
+/* read size of the baseline script reader, see putLine() */
+#define BENCH_BLOCK	1024
+
+/* runs of each script per shell unless -n is given */
+#define BENCH_RUNS	5
+
+/**
+ * struct bench - what every benchmark case runs with
+ * @self: absolute path of the bench program; scripts run "self --stamp"
+ * @dir: scratch directory, removed at exit
+ * @home: HOME of the shells, dir/home
+ * @homevar: the HOME entry of their environment
+ * @cachevar: the XDG_CACHE_HOME entry of their environment
+ * @env: their environment, see shellEnv()
+ * @shells: the baseline shell, then the shell under test
+ * @runs: how many times each script is run by each shell
+ */
+typedef struct bench
+{
+	char self[PATH_MAX];
+	char dir[64];
+	char home[PATH_MAX];
+	char homevar[PATH_MAX + 8];
+	char cachevar[PATH_MAX + 24];
+	char *env[5];
+	char *shells[2];
+	int runs;
+} bench_t;
+
+/**
+ * struct bench_case - a benchmark case
+ * @name: its name on the command line
+ * @run: runs it and prints its report; returns 0, or -1 on failure
+ */
+typedef struct bench_case
+{
+	char *name;
+	int (*run)(bench_t *b);
+} bench_case_t;
+
+/* bench.c */
+int printStamp(void);
+int removeEntry(const char *path, const struct stat *st, int flag,
+		struct FTW *ftw);
+int removeTree(char *path);
+int putLine(FILE *f, char *line);
+int main(int ac, char **av);
+
+/* bench_run.c */
+long nowNs(void);
+FILE *scratchFile(bench_t *b, char *name, char *path);
+int resetHome(bench_t *b, int entries);
+char **shellEnv(bench_t *b, int cache, char *extra);
+long runShell(bench_t *b, int shell, char *script, char **env,
+		char *out);
+
+/* bench_stats.c */
+int byNs(const void *a, const void *b);
+long percentile(long *ns, int n, int pct);
+int readStamps(char *path, long **ns, int *n);
+void printLatency(char *label, long *ns, int n);
+
+/* case_spawn.c */
+int stampScript(bench_t *b, char *path, int n);
+int stampRuns(bench_t *b, int shell, char *script, char **env,
+		int entries, long **ns, int *n);
+int spawnCase(bench_t *b);
+
+/* case_zygote.c */
+int zygoteCase(bench_t *b);
+
+/* case_lexer.c */
+long writeCorpus(bench_t *b, char *name, char *path, int lines);
+long medianRun(bench_t *b, int shell, char *script, char **env);
+int lexerCase(bench_t *b);
+
+/* case_reader.c */
+int readerCase(bench_t *b);
+
+/* case_pipe.c */
+int printReads(void);
+pid_t startProducer(char *fifo, char *script);
+long pipeRun(bench_t *b, int shell, char *script, long *reads);
+int pipeCase(bench_t *b);
+
+#endif
@@ -0,0 +1,123 @@
+#include "bench.h"
+
+/**
+ * nowNs - Reads the monotonic clock.
+ *
+ * Return: The time in nanoseconds.
+ */
+long nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+/**
+ * scratchFile - Creates a file in the scratch directory.
+ * @b: The benchmark.
+ * @name: The name of the file.
+ * @path: Set to its path; at least PATH_MAX bytes.
+ *
+ * Return: The file open for writing, or NULL on failure.
+ */
+FILE *scratchFile(bench_t *b, char *name, char *path)
+{
+    snprintf(path, PATH_MAX, "%s/%s", b->dir, name);
+    return (fopen(path, "w"));
+}
+
+/**
+ * resetHome - Gives the shells an empty HOME, or one whose history file
+ *             holds some entries.
+ * @b: The benchmark.
+ * @entries: How many entries the history file holds.
+ *
+ * Description: Runs start from the same history, whatever the previous
+ * run saved, since what the shell loads at startup is part of its
+ * memory when it launches commands.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int resetHome(bench_t *b, int entries)
+{
+    char path[PATH_MAX + 32];
+    FILE *f;
+    int i;
+
+    removeTree(b->home);
+    if (mkdir(b->home, 0700) == -1)
+        return (-1);
+    if (!entries)
+        return (0);
+    snprintf(path, sizeof(path), "%s/%s", b->home, BENCH_HISTFILE);
+    f = fopen(path, "w");
+    if (!f)
+        return (-1);
+    for (i = 0; i < entries; i++)
+        fprintf(f, "make -C build/target%d -j8 CFLAGS='-O2 -g' all\n", i);
+    return (fclose(f));
+}
+
+/**
+ * shellEnv - Gives the environment the shells run with.
+ * @b: The benchmark.
+ * @cache: If set, the shell keeps compiled scripts in the scratch
+ *         directory; otherwise it has nowhere to keep them and reads
+ *         scripts line by line.
+ * @extra: Another "NAME=value" entry, or NULL.
+ *
+ * Return: The environment, valid until the next call.
+ */
+char **shellEnv(bench_t *b, int cache, char *extra)
+{
+    snprintf(b->homevar, sizeof(b->homevar), "HOME=%s", b->home);
+    if (cache)
+        snprintf(b->cachevar, sizeof(b->cachevar), "XDG_CACHE_HOME=%s",
+                b->dir);
+    else
+        strcpy(b->cachevar, "XDG_CACHE_HOME=/dev/null");
+    b->env[0] = "PATH=/usr/local/bin:/usr/bin:/bin";
+    b->env[1] = b->homevar;
+    b->env[2] = b->cachevar;
+    b->env[3] = extra;
+    b->env[4] = NULL;
+    return (b->env);
+}
+
+/**
+ * runShell - Runs a script with one of the shells and times it.
+ * @b: The benchmark.
+ * @shell: 0 for the baseline shell, 1 for the shell under test.
+ * @script: The script.
+ * @env: The environment of the shell.
+ * @out: Where the standard output goes, or NULL to discard it.
+ *
+ * Return: The wall-clock time of the run in nanoseconds, or -1 if the
+ *         shell could not be run.
+ */
+long runShell(bench_t *b, int shell, char *script, char **env, char *out)
+{
+    posix_spawn_file_actions_t actions;
+    char *argv[3];
+    long start;
+    pid_t pid;
+    int status, err;
+
+    argv[0] = b->shells[shell];
+    argv[1] = script;
+    argv[2] = NULL;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null",
+            O_RDONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO,
+            out ? out : "/dev/null", O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    start = nowNs();
+    err = posix_spawn(&pid, argv[0], &actions, NULL, argv, env);
+    posix_spawn_file_actions_destroy(&actions);
+    if (err)
+        return (errno = err, perror(argv[0]), -1);
+    if (waitpid(pid, &status, 0) == -1)
+        return (-1);
+    return (nowNs() - start);
+}
@@ -0,0 +1,87 @@
+#include "bench.h"
+
+/**
+ * byNs - Orders durations, shortest first.
+ * @a: A duration.
+ * @b: Another duration.
+ *
+ * Return: Negative, zero or positive as a is shorter, equal or longer.
+ */
+int byNs(const void *a, const void *b)
+{
+    long x = *(const long *)a, y = *(const long *)b;
+
+    return (x < y ? -1 : x > y);
+}
+
+/**
+ * percentile - Gives a nearest-rank percentile of sorted durations.
+ * @ns: The durations, shortest first.
+ * @n: How many there are, at least one.
+ * @pct: The percentile, 1 to 100.
+ *
+ * Return: The duration that pct percent of them do not exceed.
+ */
+long percentile(long *ns, int n, int pct)
+{
+    return (ns[((long)pct * n + 99) / 100 - 1]);
+}
+
+/**
+ * readStamps - Adds the gaps between the stamps of a run to durations.
+ * @path: The output of the run, one "bench --stamp" per line.
+ * @ns: The durations, grown as needed.
+ * @n: How many there are.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int readStamps(char *path, long **ns, int *n)
+{
+    FILE *f = fopen(path, "r");
+    long stamp, prev = -1, *grown;
+
+    if (!f)
+        return (-1);
+    while (fscanf(f, "%ld", &stamp) == 1)
+    {
+        if (prev >= 0)
+        {
+            grown = realloc(*ns, sizeof(long) * (*n + 1));
+            if (!grown)
+                break;
+            *ns = grown;
+            (*ns)[(*n)++] = stamp - prev;
+        }
+        prev = stamp;
+    }
+    fclose(f);
+    return (prev >= 0 ? 0 : -1);
+}
+
+/**
+ * printLatency - Prints the median and 99th percentile of launch times
+ *                and the commands per second they make.
+ * @label: What was measured.
+ * @ns: The times; they are sorted.
+ * @n: How many there are.
+ *
+ * Return: void
+ */
+void printLatency(char *label, long *ns, int n)
+{
+    double total = 0;
+    int i;
+
+    if (n < 1)
+    {
+        printf("  %-24s no samples\n", label);
+        return;
+    }
+    qsort(ns, n, sizeof(long), byNs);
+    for (i = 0; i < n; i++)
+        total += ns[i];
+    printf("  %-24s p50 %8.1f us  p99 %8.1f us  %8.0f cmds/s\n", label,
+            percentile(ns, n, 50) / 1e3, percentile(ns, n, 99) / 1e3,
+            n / total * 1e9);
+    fflush(stdout);
+}
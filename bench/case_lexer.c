@@ -0,0 +1,117 @@
+#include "bench.h"
+
+/* lines of the corpus of the lexer case */
+#define LEXER_LINES	4000
+
+/* statements on each line of a corpus */
+#define CORPUS_REPEAT	6
+
+/**
+ * writeCorpus - Writes a script of typical configuration lines.
+ * @b: The benchmark.
+ * @name: The name of the script in the scratch directory.
+ * @path: Set to its path; at least PATH_MAX bytes.
+ * @lines: How many lines it has.
+ *
+ * Description: Lines are long and mix words, ";" and comments, and run
+ * builtins only, so the time goes to lexing and parsing rather than to
+ * launching commands or to the history each line is added to. The
+ * baseline mishandles "&&" and "||", and its alias builtin costs more
+ * than the lexer, so neither appears.
+ *
+ * Return: The number of tokens in the script, words and operators, or
+ *         -1 on failure.
+ */
+long writeCorpus(bench_t *b, char *name, char *path, int lines)
+{
+    char *forms[3], line[BENCH_BLOCK];
+    int ntok[3], i, r, len;
+    long tokens = 0;
+    FILE *f = scratchFile(b, name, path);
+
+    forms[0] = "setenv CC_%d gcc; setenv CFLAGS_%d -O2; setenv LDFLAGS_%d -s";
+    forms[1] = "setenv PATH_%d /usr/local/bin:/usr/bin:/bin";
+    forms[2] = "unsetenv TMP_%d; setenv TMP_%d /tmp/work/%d/objects";
+    ntok[0] = 11;
+    ntok[1] = 3;
+    ntok[2] = 6;
+    if (!f)
+        return (-1);
+    for (i = 0; i < lines && tokens >= 0; i++)
+    {
+        for (r = len = 0; r < CORPUS_REPEAT; r++)
+        {
+            len += snprintf(line + len, sizeof(line) - len, forms[i % 3],
+                    i % 16, i % 16, i % 16);
+            len += snprintf(line + len, sizeof(line) - len, "; ");
+        }
+        snprintf(line + len, sizeof(line) - len, "# step %d", i);
+        tokens = putLine(f, line) ? -1 :
+            tokens + CORPUS_REPEAT * (ntok[i % 3] + 1);
+    }
+    return (fclose(f) ? -1 : tokens);
+}
+
+/**
+ * medianRun - Runs a script several times and gives the median time.
+ * @b: The benchmark.
+ * @shell: 0 for the baseline shell, 1 for the shell under test.
+ * @script: The script.
+ * @env: The environment of the shell.
+ *
+ * Description: Every run starts with an empty history.
+ *
+ * Return: The median wall-clock time in nanoseconds, or -1 on failure.
+ */
+long medianRun(bench_t *b, int shell, char *script, char **env)
+{
+    long *ns = malloc(sizeof(long) * b->runs), median;
+    int i;
+
+    if (!ns)
+        return (-1);
+    for (i = 0; i < b->runs; i++)
+        if (resetHome(b, 0) == -1 ||
+                (ns[i] = runShell(b, shell, script, env, NULL)) == -1)
+            return (free(ns), -1);
+    qsort(ns, b->runs, sizeof(long), byNs);
+    median = percentile(ns, b->runs, 50);
+    free(ns);
+    return (median);
+}
+
+/**
+ * lexerCase - Compares how many tokens per second the shells get
+ *             through on a corpus of script lines.
+ * @b: The benchmark.
+ *
+ * Description: The time of an empty script is taken off, so startup is
+ * not counted. The corpus runs builtins, which count with the lexing
+ * and parsing of each line. Compiled scripts are off, so the shell
+ * under test lexes every line.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int lexerCase(bench_t *b)
+{
+    char corpus[PATH_MAX], empty[PATH_MAX], *labels[2];
+    long tokens = writeCorpus(b, "corpus.sh", corpus, LEXER_LINES);
+    long full, none;
+    int i;
+
+    labels[0] = "baseline";
+    labels[1] = "single-pass lexer";
+    if (tokens <= 0 || writeCorpus(b, "empty.sh", empty, 0) == -1)
+        return (-1);
+    for (i = 0; i < 2; i++)
+    {
+        full = medianRun(b, i, corpus, shellEnv(b, 0, NULL));
+        none = medianRun(b, i, empty, shellEnv(b, 0, NULL));
+        if (full == -1 || none == -1)
+            return (-1);
+        printf("  %-24s %8.1f ms  %10.0f tokens/s\n", labels[i],
+                (full - none) / 1e6, tokens / ((full - none) / 1e9));
+        fflush(stdout);
+    }
+    return (0);
+}
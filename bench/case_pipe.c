@@ -0,0 +1,154 @@
+#include "bench.h"
+
+/* lines of the script of the pipe case, 512 bytes each */
+#define PIPE_LINES	8192
+
+/* capacity the producer asks for its pipe, /proc/sys/fs/pipe-max-size */
+#define PIPE_CAPACITY	1048576
+
+/**
+ * printReads - Prints how much the parent process has read so far.
+ *
+ * Description: This is what "bench --reads" does. A script runs it as
+ * its last command, so its parent is the shell reading the script, and
+ * the bytes and read() calls of /proc/PID/io are those of the shell.
+ *
+ * Return: 0 on success, 1 on failure.
+ */
+int printReads(void)
+{
+    char path[64], line[128];
+    long rchar = -1, syscr = -1;
+    FILE *f;
+
+    snprintf(path, sizeof(path), "/proc/%d/io", (int)getppid());
+    f = fopen(path, "r");
+    if (!f)
+        return (1);
+    while (fgets(line, sizeof(line), f))
+    {
+        sscanf(line, "rchar: %ld", &rchar);
+        sscanf(line, "syscr: %ld", &syscr);
+    }
+    fclose(f);
+    printf("%ld %ld\n", rchar, syscr);
+    return (rchar < 0 || syscr < 0);
+}
+
+/**
+ * startProducer - Forks a process that writes a script into a FIFO as
+ *                 fast as the reader takes it.
+ * @fifo: The FIFO the shell reads the script from.
+ * @script: The script.
+ *
+ * Description: The pipe is enlarged to PIPE_CAPACITY, as a producer
+ * such as a build tool's pipe may be, so the shell always finds more
+ * waiting than it reads.
+ *
+ * Return: The pid of the producer, or -1 on failure.
+ */
+pid_t startProducer(char *fifo, char *script)
+{
+    char buf[65536];
+    ssize_t n;
+    pid_t pid = fork();
+    int in, out;
+
+    if (pid)
+        return (pid);
+    out = open(fifo, O_WRONLY);
+    in = open(script, O_RDONLY);
+    if (out == -1 || in == -1)
+        _exit(1);
+    fcntl(out, F_SETPIPE_SZ, PIPE_CAPACITY);
+    while ((n = read(in, buf, sizeof(buf))) > 0)
+        if (write(out, buf, n) != n)
+            _exit(1);
+    _exit(n == 0 ? 0 : 1);
+}
+
+/**
+ * pipeRun - Runs the script of the pipe case through a FIFO once.
+ * @b: The benchmark.
+ * @shell: 0 for the baseline shell, 1 for the shell under test.
+ * @script: The script, which ends with "bench --reads".
+ * @reads: Set to the bytes the shell read, then its read() calls.
+ *
+ * Return: The wall-clock time of the run in nanoseconds, or -1 on
+ *         failure.
+ */
+long pipeRun(bench_t *b, int shell, char *script, long *reads)
+{
+    char fifo[PATH_MAX], out[PATH_MAX];
+    long ns;
+    pid_t producer;
+    FILE *f;
+    int fd;
+
+    snprintf(fifo, sizeof(fifo), "%s/script.fifo", b->dir);
+    snprintf(out, sizeof(out), "%s/reads", b->dir);
+    unlink(fifo);
+    if (resetHome(b, 0) == -1 || mkfifo(fifo, 0600) == -1)
+        return (-1);
+    producer = startProducer(fifo, script);
+    if (producer == -1)
+        return (-1);
+    ns = runShell(b, shell, fifo, shellEnv(b, 0, NULL), out);
+    /* a shell that never opened the FIFO leaves the producer blocked */
+    fd = open(fifo, O_RDONLY | O_NONBLOCK);
+    if (fd != -1)
+        close(fd);
+    waitpid(producer, NULL, 0);
+    f = fopen(out, "r");
+    if (!f || fscanf(f, "%ld %ld", reads, reads + 1) != 2 || reads[1] < 1)
+        ns = -1;
+    if (f)
+        fclose(f);
+    return (ns);
+}
+
+/**
+ * pipeCase - Compares how the shells read a script that a fast producer
+ *            pipes in.
+ * @b: The benchmark.
+ *
+ * Description: The baseline reads 1024 bytes at a time. The shell under
+ * test starts with a 64 KiB input buffer and grows it while reads keep
+ * finding it nearly full, so the average read shows how far it grew.
+ * The script runs builtins only; the numbers are those of the fastest
+ * run.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int pipeCase(bench_t *b)
+{
+    char script[PATH_MAX], line[PATH_MAX + 16], *labels[2];
+    long ns, best, reads[2], kept[2] = {0, 1};
+    FILE *f;
+    int i, r, ret;
+
+    labels[0] = "baseline (1 KiB reads)";
+    labels[1] = "growing buffer";
+    snprintf(line, sizeof(line), "%s --reads", b->self);
+    if (writeCorpus(b, "pipe.sh", script, PIPE_LINES) <= 0)
+        return (-1);
+    f = fopen(script, "a");
+    ret = !f || putLine(f, line) == -1;
+    if (!f || fclose(f) || ret)
+        return (-1);
+    for (i = 0; i < 2; i++)
+    {
+        for (r = 0, best = -1; r < b->runs; r++)
+        {
+            ns = pipeRun(b, i, script, reads);
+            if (ns == -1)
+                return (-1);
+            if (best == -1 || ns < best)
+                best = ns, kept[0] = reads[0], kept[1] = reads[1];
+        }
+        printf("  %-24s %8.1f ms  %8ld reads  %8.1f KiB/read\n", labels[i],
+                best / 1e6, kept[1], kept[0] / 1024.0 / kept[1]);
+        fflush(stdout);
+    }
+    return (0);
+}
@@ -0,0 +1,46 @@
+#include "bench.h"
+
+/* lines of the script of the reader case, 512 bytes each */
+#define READER_LINES	8192
+
+/**
+ * readerCase - Compares how fast the shells get through a script of
+ *              several megabytes.
+ * @b: The benchmark.
+ *
+ * Description: The baseline reads scripts 1024 bytes at a time; the
+ * shell under test maps them, and with compiled scripts on it maps the
+ * compiled form it saved on a first, untimed run instead. The time of
+ * an empty script is taken off, so startup is not counted.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int readerCase(bench_t *b)
+{
+    char script[PATH_MAX], empty[PATH_MAX], *labels[3];
+    long full, none;
+    struct stat st;
+    int i;
+
+    labels[0] = "baseline (1 KiB reads)";
+    labels[1] = "mmap reader";
+    labels[2] = "compiled script";
+    if (writeCorpus(b, "reader.sh", script, READER_LINES) <= 0 ||
+            writeCorpus(b, "empty.sh", empty, 0) == -1 ||
+            stat(script, &st) == -1)
+        return (-1);
+    for (i = 0; i < 3; i++)
+    {
+        if (i == 2 && runShell(b, 1, script, shellEnv(b, 1, NULL),
+                    NULL) == -1)
+            return (-1);
+        full = medianRun(b, i > 0, script, shellEnv(b, i == 2, NULL));
+        none = medianRun(b, i > 0, empty, shellEnv(b, i == 2, NULL));
+        if (full == -1 || none == -1)
+            return (-1);
+        printf("  %-24s %8.1f ms  %8.1f MB/s\n", labels[i],
+                (full - none) / 1e6, st.st_size / ((full - none) / 1e3));
+        fflush(stdout);
+    }
+    return (0);
+}
@@ -0,0 +1,87 @@
+#include "bench.h"
+
+/* commands each run of a launch script runs */
+#define SPAWN_CMDS	1000
+
+/**
+ * stampScript - Writes a script that runs "bench --stamp" over and over.
+ * @b: The benchmark.
+ * @path: Set to the path of the script; at least PATH_MAX bytes.
+ * @n: How many times it runs it.
+ *
+ * Description: The command is named by its path, so neither PATH lookup
+ * nor the command hash takes part.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int stampScript(bench_t *b, char *path, int n)
+{
+    FILE *f = scratchFile(b, "stamp.sh", path);
+    char line[PATH_MAX + 16];
+    int i, ret = 0;
+
+    if (!f)
+        return (-1);
+    snprintf(line, sizeof(line), "%s --stamp", b->self);
+    for (i = 0; i < n && ret == 0; i++)
+        ret = putLine(f, line);
+    return (fclose(f) || ret ? -1 : 0);
+}
+
+/**
+ * stampRuns - Runs a stamp script several times and collects the time
+ *             each command took to launch.
+ * @b: The benchmark.
+ * @shell: 0 for the baseline shell, 1 for the shell under test.
+ * @script: The script, from stampScript().
+ * @env: The environment of the shell.
+ * @entries: How many entries the history of the shell starts with.
+ * @ns: Set to the allocated times.
+ * @n: Set to how many there are.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int stampRuns(bench_t *b, int shell, char *script, char **env,
+        int entries, long **ns, int *n)
+{
+    char out[PATH_MAX];
+    int i;
+
+    *ns = NULL;
+    *n = 0;
+    snprintf(out, sizeof(out), "%s/stamps", b->dir);
+    for (i = 0; i < b->runs; i++)
+        if (resetHome(b, entries) == -1 ||
+                runShell(b, shell, script, env, out) == -1 ||
+                readStamps(out, ns, n) == -1)
+            return (-1);
+    return (0);
+}
+
+/**
+ * spawnCase - Compares how fast the shells launch external commands.
+ * @b: The benchmark.
+ *
+ * Description: The baseline forks and execs each command; the shell
+ * under test uses posix_spawn() for commands with no redirection.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int spawnCase(bench_t *b)
+{
+    char script[PATH_MAX];
+    long *ns[2];
+    int n[2], i, ret = 0;
+
+    if (stampScript(b, script, SPAWN_CMDS) == -1)
+        return (-1);
+    for (i = 0; i < 2; i++)
+        if (stampRuns(b, i, script, shellEnv(b, 0, NULL), 0, ns + i,
+                    n + i) == -1)
+            ret = -1;
+    printLatency("baseline (fork)", ns[0], n[0]);
+    printLatency("posix_spawn", ns[1], n[1]);
+    free(ns[0]);
+    free(ns[1]);
+    return (ret);
+}
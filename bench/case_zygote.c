@@ -0,0 +1,38 @@
+#include "bench.h"
+
+/* commands each run of the zygote case runs */
+#define ZYGOTE_CMDS	1000
+
+/**
+ * zygoteCase - Compares launch times through the zygote helper with
+ *              direct launches, with a full history.
+ * @b: The benchmark.
+ *
+ * Description: Each shell starts with BENCH_HISTORY entries in its
+ * history, as a long-lived interactive shell has, so fork() has that
+ * much more memory to copy. The baseline forks the shell itself; the
+ * shell under test uses posix_spawn(), then with HSH_ZYGOTE set asks
+ * the helper it forked at startup.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int zygoteCase(bench_t *b)
+{
+    char script[PATH_MAX];
+    long *ns[3];
+    int n[3], i, ret = 0;
+
+    if (stampScript(b, script, ZYGOTE_CMDS) == -1)
+        return (-1);
+    for (i = 0; i < 3; i++)
+        if (stampRuns(b, i > 0, script, shellEnv(b, 0, i == 2 ?
+                        "HSH_ZYGOTE=1" : NULL), BENCH_HISTORY, ns + i,
+                    n + i) == -1)
+            ret = -1;
+    printLatency("baseline (fork)", ns[0], n[0]);
+    printLatency("posix_spawn", ns[1], n[1]);
+    printLatency("zygote", ns[2], n[2]);
+    for (i = 0; i < 3; i++)
+        free(ns[i]);
+    return (ret);
+}
@@ -0,0 +1,27 @@
+#!/bin/sh
+# Builds the shell of the working tree and the one of a baseline commit
+# (BASE, the first commit by default) with the same flags, then times
+# them against each other.
+#
+# usage: bench/run.sh [-n runs] [case...]
+
+set -e
+top=$(cd "$(dirname "$0")/.." && pwd)
+base=${BASE:-$(git -C "$top" rev-list --max-parents=0 HEAD)}
+cflags="-O2 -std=gnu89"
+runs=
+if [ "$1" = "-n" ]; then
+	runs="-n $2"
+	shift 2
+fi
+
+out=$(mktemp -d /tmp/hsh-build.XXXXXX)
+trap 'rm -rf "$out"' EXIT
+mkdir "$out/base"
+git -C "$top" archive "$base" | tar -x -C "$out/base"
+(cd "$out/base" && gcc $cflags *.c -o "$out/hsh-base")
+(cd "$top" && gcc $cflags *.c -o "$out/hsh")
+gcc $cflags -Wall -Werror -Wextra -pedantic "$top"/bench/*.c -o "$out/bench"
+
+echo "baseline $(git -C "$top" rev-parse --short "$base"), tree $(git -C "$top" rev-parse --short HEAD)"
+"$out/bench" $runs "$out/hsh-base" "$out/hsh" "$@"
@@ -0,0 +1,81 @@
+#include "shell.h"
+
+/*
+ * Builtins indexed by builtinHash(). The hash is perfect for this set:
+ * every builtin has a slot of its own, so a lookup is one hash and one
+ * _strcmp(). When adding a builtin, put it in slot builtinHash(name); if
+ * that slot is taken, pick new multipliers so all names stay unique.
+ */
+static builtin_table builtintbl[BUILTIN_HASH_SIZE] = {
+	{"bg",       shell_bg},
+	{"command",  shell_command},
+	{"env",      shellEnvironment},
+	{"alias",    alias},
+	{"fg",       shell_fg},
+	{NULL,       NULL},
+	{"setenv",   _mysetenv},
+	{NULL,       NULL},
+	{NULL,       NULL},
+	{NULL,       NULL},
+	{NULL,       NULL},
+	{NULL,       NULL},
+	{"type",     shell_type},
+	{NULL,       NULL},
+	{"wait",     shell_wait},
+	{NULL,       NULL},
+	{NULL,       NULL},
+	{"cd",       shell_cd},
+	{NULL,       NULL},
+	{"hash",     shell_hash},
+	{NULL,       NULL},
+	{"unsetenv", _myunsetenv},
+	{NULL,       NULL},
+	{"help",     shell_help},
+	{"timeout",  shell_timeout},
+	{"history",  shell_history},
+	{"jobs",     shell_jobs},
+	{"parallel", shell_parallel},
+	{NULL,       NULL},
+	{"exit",     exitShell},
+	{NULL,       NULL},
+	{NULL,       NULL}
+};
+
+/**
+ * builtinHash - computes the slot of a name in the builtin table
+ * @name: a non-empty command name
+ *
+ * Description: mixes the first, second and last characters with the
+ * length, so only one pass over the name is needed.
+ *
+ * Return: the slot in the range [0, BUILTIN_HASH_SIZE)
+ */
+unsigned int builtinHash(const char *name)
+{
+	unsigned int len = 0;
+
+	while (name[len])
+		len++;
+
+	return ((unsigned char)name[0] + 7 * (unsigned char)name[1] +
+		9 * (unsigned char)name[len - 1] + 7 * len) % BUILTIN_HASH_SIZE;
+}
+
+/**
+ * getBuiltin - looks up a builtin by name without running it
+ * @name: the command name
+ *
+ * Return: the builtin table entry, or NULL if name is not a builtin
+ */
+builtin_table *getBuiltin(char *name)
+{
+	builtin_table *entry;
+
+	if (!name || !name[0])
+		return (NULL);
+
+	entry = &builtintbl[builtinHash(name)];
+	if (entry->type && _strcmp(name, entry->type) == 0)
+		return (entry);
+	return (NULL);
+}
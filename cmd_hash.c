@@ -0,0 +1,125 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * hashName - Computes the bucket of a command name (djb2).
+ * @name: The command name.
+ *
+ * Return: Bucket index in the range [0, CMD_HASH_SIZE).
+ */
+unsigned int hashName(const char *name)
+{
+    unsigned long hash = 5381;
+
+    while (*name)
+        hash = ((hash << 5) + hash) + (unsigned char)*name++;
+
+    return ((unsigned int)(hash & (CMD_HASH_SIZE - 1)));
+}
+
+/**
+ * hashFind - Finds the cache node of a command.
+ * @info: The parameter struct holding the command hash table.
+ * @cmd: The command name.
+ *
+ * Description: Nodes store "cmd=/abs/path" in str and the hit count in num.
+ *
+ * Return: The matching node, or NULL if the command is not cached.
+ */
+list_t *hashFind(shell_info *info, char *cmd)
+{
+    if (!info->cmd_hash || !cmd)
+        return (NULL);
+
+    return (nodeStartsWith(info->cmd_hash[hashName(cmd)], cmd, '='));
+}
+
+/**
+ * hashLookup - Returns the cached absolute path of a command.
+ * @info: The parameter struct holding the command hash table.
+ * @cmd: The command name.
+ *
+ * Description: A cached path that is no longer executable is dropped, so
+ * the caller falls back to a full PATH search.
+ *
+ * Return: The cached path, or NULL on a miss.
+ */
+char *hashLookup(shell_info *info, char *cmd)
+{
+    list_t *node = hashFind(info, cmd);
+    list_t **bucket;
+    char *path;
+
+    if (!node)
+        return (NULL);
+
+    path = _strchr(node->str, '=') + 1;
+    if (isCmd(info, path))
+    {
+        node->num++;
+        return (path);
+    }
+
+    bucket = &(info->cmd_hash[hashName(cmd)]);
+    remove_node_at(bucket, get_node_index(*bucket, node));
+    return (NULL);
+}
+
+/**
+ * hashInsert - Remembers the absolute path of a command.
+ * @info: The parameter struct holding the command hash table.
+ * @cmd: The command name, used as the key.
+ * @path: The absolute path to remember.
+ *
+ * Return: The new cache node, or NULL on failure.
+ */
+list_t *hashInsert(shell_info *info, char *cmd, char *path)
+{
+    list_t *node, **bucket;
+    char *entry;
+
+    if (!info->cmd_hash)
+    {
+        info->cmd_hash = malloc(sizeof(list_t *) * CMD_HASH_SIZE);
+        if (!info->cmd_hash)
+            return (NULL);
+        _memset((char *)info->cmd_hash, 0, sizeof(list_t *) * CMD_HASH_SIZE);
+    }
+
+    bucket = &(info->cmd_hash[hashName(cmd)]);
+    node = nodeStartsWith(*bucket, cmd, '=');
+    if (node)
+        remove_node_at(bucket, get_node_index(*bucket, node));
+
+    entry = malloc(_strlen(cmd) + _strlen(path) + 2);
+    if (!entry)
+        return (NULL);
+    _strcpy(entry, cmd);
+    _strcat(entry, "=");
+    _strcat(entry, path);
+
+    node = prepend_node(bucket, entry, 0);
+    free(entry);
+    return (node);
+}
+
+/**
+ * hashClear - Forgets every cached command path.
+ * @info: The parameter struct holding the command hash table.
+ * @all: If true, the bucket array itself is released as well.
+ *
+ * Return: void
+ */
+void hashClear(shell_info *info, int all)
+{
+    int i;
+
+    if (!info->cmd_hash)
+        return;
+
+    for (i = 0; i < CMD_HASH_SIZE; i++)
+        free_linked_list(&(info->cmd_hash[i]));
+
+    if (all)
+        bfree((void **)&(info->cmd_hash));
+}
@@ -0,0 +1,100 @@
+#include "shell.h"
+
+/**
+ * usecSince - Measures the wall-clock time elapsed since a moment.
+ * @start: The moment, taken from CLOCK_MONOTONIC.
+ *
+ * Return: The elapsed time in microseconds.
+ */
+long usecSince(struct timespec *start)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((now.tv_sec - start->tv_sec) * 1000000L +
+            (now.tv_nsec - start->tv_nsec) / 1000);
+}
+
+/**
+ * startTiming - Starts measuring a command line or a timed pipeline.
+ * @info: The parameter struct.
+ *
+ * Return: void
+ */
+void startTiming(shell_info *info)
+{
+    _memset((char *)&info->usage, 0, sizeof(info->usage));
+    clock_gettime(CLOCK_MONOTONIC, &info->cmd_start);
+}
+
+/**
+ * addUsage - Adds the resources used by a reaped child to the command.
+ * @info: The parameter struct.
+ * @ru: The rusage returned by wait4() or waitid(), or NULL.
+ *
+ * Description: Times and context switches of the stages of a pipeline
+ * add up; the peak RSS is that of the largest stage.
+ *
+ * Return: void
+ */
+void addUsage(shell_info *info, struct rusage *ru)
+{
+    if (!ru)
+        return;
+
+    info->usage.user += ru->ru_utime.tv_sec * 1000000L + ru->ru_utime.tv_usec;
+    info->usage.sys += ru->ru_stime.tv_sec * 1000000L + ru->ru_stime.tv_usec;
+    if (ru->ru_maxrss > info->usage.maxrss)
+        info->usage.maxrss = ru->ru_maxrss;
+    info->usage.nvcsw += ru->ru_nvcsw;
+    info->usage.nivcsw += ru->ru_nivcsw;
+}
+
+/**
+ * stopTiming - Finishes measuring what startTiming() started.
+ * @info: The parameter struct.
+ *
+ * Return: void
+ */
+void stopTiming(shell_info *info)
+{
+    info->usage.real = usecSince(&info->cmd_start);
+}
+
+/**
+ * printUsage - Reports the resources used by the last command on stderr.
+ * @info: The parameter struct.
+ *
+ * Description: real/user/sys use the layout of other shells, followed by
+ * the peak RSS and the voluntary+involuntary context switches.
+ *
+ * Return: void
+ */
+void printUsage(shell_info *info)
+{
+    char *labels[3];
+    long times[3];
+    int i;
+
+    labels[0] = "\nreal\t";
+    labels[1] = "user\t";
+    labels[2] = "sys\t";
+    times[0] = info->usage.real;
+    times[1] = info->usage.user;
+    times[2] = info->usage.sys;
+    for (i = 0; i < 3; i++)
+    {
+        _eputs(labels[i]);
+        _eputs(convert_number(times[i] / 60000000, 10, 0));
+        _eputs("m");
+        _eputs(convert_fixed(times[i] % 60000000, 1000000));
+        _eputs("s\n");
+    }
+    _eputs("maxrss\t");
+    _eputs(convert_number(info->usage.maxrss, 10, 0));
+    _eputs("k\ncsw\t");
+    _eputs(convert_number(info->usage.nvcsw, 10, 0));
+    _eputs("+");
+    _eputs(convert_number(info->usage.nivcsw, 10, 0));
+    _eputs("\n");
+}
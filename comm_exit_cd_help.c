@@ -9,7 +9,7 @@
  * If info->argv[1] is not a valid number, an error message is displayed,
  * and the function returns without exiting.
  *
- * Return: 1 if there is an error in exit argument, -2 to indicate shell exit.
+ * Return: 2 if there is an error in exit argument, -2 to indicate shell exit.
  */
 int exitShell(shell_info *info)
 {
@@ -27,7 +27,7 @@ int exitShell(shell_info *info)
             print_error(info, "Illegal number: ");
             _eputs(info->argv[1]);
             _buffered_err_putchar('\n');
-            return (1);
+            return (2);
         }
 
         info->err_num = exit_status;
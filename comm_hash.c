@@ -0,0 +1,98 @@
+#include "shell.h"
+
+/**
+ * printHashTable - Prints the cached commands and their hit counts.
+ * @info: The parameter struct holding the command hash table.
+ *
+ * Return: 0 if at least one entry was printed, 1 if the table is empty.
+ */
+int printHashTable(shell_info *info)
+{
+    list_t *node;
+    int i, printed = 0;
+
+    for (i = 0; info->cmd_hash && i < CMD_HASH_SIZE; i++)
+    {
+        for (node = info->cmd_hash[i]; node; node = node->next)
+        {
+            if (!printed++)
+                _puts("hits\tcommand\n");
+            _puts(convert_number(node->num, 10, 0));
+            _putchar('\t');
+            _puts(_strchr(node->str, '=') + 1);
+            _putchar('\n');
+        }
+    }
+
+    if (!printed)
+    {
+        _puts("hash: hash table empty\n");
+        return (1);
+    }
+    return (0);
+}
+
+/**
+ * hashCommand - Searches PATH for a command and caches the result.
+ * @info: The parameter struct holding the command hash table.
+ * @cmd: The command name to resolve.
+ *
+ * Return: 0 on success, 1 if the command could not be found.
+ */
+int hashCommand(shell_info *info, char *cmd)
+{
+    char *path;
+
+    if (_strchr(cmd, '/'))
+        return (0);
+
+    path = findPath(info, getEnvironment(info, "PATH="), cmd);
+    if (!path || !hashInsert(info, cmd, path))
+    {
+        _eputs("hash: ");
+        _eputs(cmd);
+        _eputs(": not found\n");
+        return (1);
+    }
+    return (0);
+}
+
+/**
+ * shell_hash - Mimics the hash builtin command.
+ * @info: Structure containing potential arguments.
+ *
+ * Description: Without arguments the cache is listed, "-r" forgets every
+ * entry, "-p path name..." preloads names with the given path and any
+ * other argument is looked up in PATH and remembered.
+ *
+ * Return: 0 on success, 1 on error; info->status is set to it.
+ */
+int shell_hash(shell_info *info)
+{
+    int i, ret = 0;
+
+    if (info->argc == 1)
+        return (info->status = printHashTable(info));
+
+    if (_strcmp(info->argv[1], "-r") == 0)
+    {
+        hashClear(info, 0);
+        return (info->status = 0);
+    }
+
+    if (_strcmp(info->argv[1], "-p") == 0)
+    {
+        if (info->argc < 4)
+        {
+            _eputs("hash: usage: hash -p path name\n");
+            return (info->status = 1);
+        }
+        for (i = 3; info->argv[i]; i++)
+            ret |= (hashInsert(info, info->argv[i], info->argv[2]) == NULL);
+        return (info->status = ret);
+    }
+
+    for (i = 1; info->argv[i]; i++)
+        ret |= hashCommand(info, info->argv[i]);
+    return (info->status = ret);
+}
@@ -0,0 +1,150 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * historyOptions - Runs the history builtin given options.
+ * @info: The parameter struct; info->argv holds the options.
+ *
+ * Description: "-s pattern" prints the entries holding the pattern,
+ * "--export [file]" writes the history in the text format to the file
+ * or the standard output and "--import file" adds the lines of a file
+ * in that format to the history. "--slowest [n]" prints the n entries
+ * that ran longest, "--failed" those that exited with a non-zero status
+ * and "--stats" the runs, failures and durations of each command.
+ *
+ * Return: 0 on success, 1 if nothing was found or on failure, 2 on a
+ *         usage error.
+ */
+int historyOptions(shell_info *info)
+{
+    char *opt = info->argv[1];
+    int n;
+
+    if (_strcmp(opt, "-s") == 0 && info->argc == 3)
+        return (printMatches(info, info->argv[2]) ? 0 : 1);
+    if (_strcmp(opt, "--export") == 0 && info->argc <= 3)
+        return (exportHistory(info, info->argv[2]));
+    if (_strcmp(opt, "--import") == 0 && info->argc == 3)
+        return (importHistory(info, info->argv[2]));
+    if (_strcmp(opt, "--slowest") == 0 && info->argc <= 3 &&
+            (n = printSlowest(info, info->argv[2])) >= 0)
+        return (n ? 0 : 1);
+    if (_strcmp(opt, "--failed") == 0 && info->argc == 2)
+        return (printFailed(info) ? 0 : 1);
+    if (_strcmp(opt, "--stats") == 0 && info->argc == 2)
+        return (printStats(info) ? 0 : 1);
+    _eputs("history: usage: history [-s pattern] [--export [file]] ");
+    _eputs("[--import file]\n       history [--slowest [n]] [--failed] ");
+    _eputs("[--stats]\n");
+    return (2);
+}
+
+/**
+ * exportHistory - Writes the history in the text format.
+ * @info: The parameter struct holding the history.
+ * @file: Where to write it, or NULL for the standard output.
+ *
+ * Return: 0 on success, 1 on failure.
+ */
+int exportHistory(shell_info *info, char *file)
+{
+    char *text;
+    size_t size, done = 0;
+    ssize_t wrote = 1;
+    int fd = STDOUT_FILENO;
+
+    text = historyText(info, &size);
+    if (text && file)
+        fd = open(file, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (!text || fd == -1)
+    {
+        print_error(info, "can't write ");
+        _eputs(file ? file : "history"), _buffered_err_putchar('\n');
+        return (free(text), 1);
+    }
+
+    _putchar(BUF_FLUSH);
+    while (done < size && wrote > 0)
+    {
+        wrote = write(fd, text + done, size - done);
+        done += wrote > 0 ? wrote : 0;
+    }
+    if (file)
+        close(fd);
+    free(text);
+    return (done == size ? 0 : 1);
+}
+
+/**
+ * importHistory - Adds the lines of a file in the text format to the
+ *                 history.
+ * @info: The parameter struct.
+ * @file: The file.
+ *
+ * Description: Each line goes through append_to_history(), as if typed:
+ * HISTCONTROL applies and the line is journaled.
+ *
+ * Return: 0 on success, 1 if the file cannot be read.
+ */
+int importHistory(shell_info *info, char *file)
+{
+    struct stat st;
+    char *buf = NULL, *line, *nl, *end;
+    int fd = open(file, O_RDONLY | O_CLOEXEC);
+
+    if (fd != -1 && fstat(fd, &st) == 0)
+        buf = malloc(st.st_size + 1);
+    if (!buf || read(fd, buf, st.st_size) != st.st_size)
+    {
+        print_error(info, "can't read ");
+        _eputs(file), _buffered_err_putchar('\n');
+        if (fd != -1)
+            close(fd);
+        return (free(buf), 1);
+    }
+    close(fd);
+
+    end = buf + st.st_size;
+    *end = '\0';
+    for (line = buf; line < end; line = nl + 1)
+    {
+        nl = memchr(line, '\n', end - line);
+        nl = nl ? nl : end;
+        *nl = '\0';
+        if (*line)
+            append_to_history(info, line);
+    }
+    free(buf);
+    return (0);
+}
+
+/**
+ * printMatches - Prints the history entries holding a pattern.
+ * @info: The parameter struct.
+ * @pattern: The pattern.
+ *
+ * Return: The number of entries printed.
+ */
+int printMatches(shell_info *info, char *pattern)
+{
+    history_t *h = info->history;
+    hist_entry_t *e;
+    int *found, n = 0, pos;
+
+    found = h ? malloc(sizeof(int) * (h->count + 1)) : NULL;
+    if (!found)
+        return (0);
+    for (pos = historySearch(h, pattern, h->count); pos >= 0;
+            pos = historySearch(h, pattern, pos))
+        found[n++] = pos;
+    for (pos = n; pos > 0; pos--)
+    {
+        e = historyAt(h, found[pos - 1]);
+        _puts(convert_number(e->num, 10, 0));
+        _puts(": ");
+        _puts(h->arena + e->off);
+        _putchar('\n');
+    }
+    free(found);
+    return (n);
+}
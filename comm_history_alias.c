@@ -6,24 +6,27 @@
  * @info: Structure containing potential arguments. Used to maintain
  *        a constant function prototype.
  *
- * Description: Utilizes the printList function to display the history
+ * Description: Utilizes the printHistory function to display the history
  * of commands executed in the shell, each preceded by a line number,
- * starting from 0.
+ * starting from 0. Options are handled by historyOptions().
  *
- * Return: Always returns 0.
+ * Return: 0, or the status of historyOptions(); info->status is set to
+ *         it.
  */
 int shell_history(shell_info *info)
 {
-    if (info && info->history)
+    if (info->argc > 1)
+        return (info->status = historyOptions(info));
+    if (info && info->history && info->history->count)
     {
-        printList(info->history);
+        printHistory(info);
     }
     else
     {
         _puts("No history available.\n");
     }
 
-    return (0);
+    return (info->status = 0);
 }
 
 
@@ -47,6 +50,7 @@ int unsetAlias(shell_info *info, char *str)
         return (1); /* Alias not found */
 
     /* Remove the alias node */
+    info->state_gen++;
     return remove_node_at(&(info->alias), node_index) == 0 ? 0 : 1;
 }
 
@@ -72,6 +76,7 @@ int setAlias(shell_info *info, char *str)
 
     /* Unset the existing alias before setting the new one */
     unsetAlias(info, str);
+    info->state_gen++;
 
     /* Add the new alias to the end of the alias list */
     return (append_node(&(info->alias), str, 0) == NULL);
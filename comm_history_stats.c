@@ -0,0 +1,109 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * printSlowest - Prints the history entries that ran longest.
+ * @info: The parameter struct holding the history.
+ * @count: How many to print, or NULL for 10.
+ *
+ * Return: The number of entries printed, or -1 if count is not a
+ *         positive number.
+ */
+int printSlowest(shell_info *info, char *count)
+{
+    hist_run_t *runs;
+    int max = count ? _erratoi(count) : 10, n, i;
+
+    if (max <= 0)
+        return (-1);
+    runs = historyRuns(info, 0, &n);
+    for (i = 0; i < n && i < max; i++)
+        printRun(info->history, runs[i].e);
+    free(runs);
+    return (i);
+}
+
+/**
+ * printFailed - Prints the history entries that exited with a non-zero
+ *               status, oldest first.
+ * @info: The parameter struct holding the history.
+ *
+ * Return: The number of entries printed.
+ */
+int printFailed(shell_info *info)
+{
+    hist_entry_t *e;
+    int n = 0, i;
+
+    for (i = 0; (e = historyAt(info->history, i)); i++)
+        if (!e->dead && e->status > 0)
+            printRun(info->history, e), n++;
+    return (n);
+}
+
+/**
+ * printStats - Prints, for each command name in the history, how many
+ *              times it ran, how many of them failed and the
+ *              percentiles of its durations.
+ * @info: The parameter struct holding the history.
+ *
+ * Description: The name is the first word of the line as typed, before
+ * any alias or expansion. Only entries whose duration is known count.
+ *
+ * Return: The number of commands printed.
+ */
+int printStats(shell_info *info)
+{
+    hist_run_t *runs;
+    int n, i, j, failed, cmds = 0;
+    size_t k;
+
+    runs = historyRuns(info, 1, &n);
+    if (runs)
+        _puts("command\truns\tfailed\tp50\tp90\tp99\tmax\n");
+    for (i = 0; i < n; i = j, cmds++)
+    {
+        failed = 0;
+        for (j = i; j < n && runs[j].len == runs[i].len &&
+                !memcmp(runs[j].name, runs[i].name, runs[i].len); j++)
+            failed += runs[j].e->status > 0;
+        for (k = 0; k < runs[i].len; k++)
+            _putchar(runs[i].name[k]);
+        _putchar('\t');
+        _puts(convert_number(j - i, 10, 0));
+        _putchar('\t');
+        _puts(convert_number(failed, 10, 0));
+        printPercentiles(runs + i, j - i);
+    }
+    free(runs);
+    return (cmds);
+}
+
+/**
+ * printPercentiles - Prints the 50th, 90th and 99th percentiles and the
+ *                    maximum of the durations of runs.
+ * @runs: The runs, slowest first.
+ * @n: How many there are.
+ *
+ * Description: A percentile is the nearest-rank one: the duration that
+ * p percent of the runs do not exceed, taken from the runs themselves.
+ *
+ * Return: void
+ */
+void printPercentiles(hist_run_t *runs, int n)
+{
+    int pct[3], rank, i;
+
+    pct[0] = 50;
+    pct[1] = 90;
+    pct[2] = 99;
+    for (i = 0; i < 3; i++)
+    {
+        rank = (pct[i] * n + 99) / 100;
+        _putchar('\t');
+        putDuration(runs[n - rank].usec);
+    }
+    _putchar('\t');
+    putDuration(runs[0].usec);
+    _putchar('\n');
+}
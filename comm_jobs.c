@@ -0,0 +1,150 @@
+#include "shell.h"
+#include <signal.h>
+
+/**
+ * waitJob - Blocks until a job finishes or stops.
+ * @job: The job to wait for.
+ *
+ * Return: The exit status of the job, 128 + SIGTSTP if it stopped, or
+ *         127 if it cannot be waited for.
+ */
+int waitJob(job_t *job)
+{
+    int status;
+
+    while (job->state == JOB_RUNNING)
+    {
+        if (waitPidfd(job->pidfd, job->pid, &status, WUNTRACED) == -1)
+        {
+            /* not a child of this shell any more: its status is lost */
+            updateJob(job, W_EXITCODE(127, 0));
+            break;
+        }
+        updateJob(job, status);
+    }
+
+    if (job->state == JOB_STOPPED)
+        return (128 + SIGTSTP);
+    return (job->status);
+}
+
+/**
+ * shell_jobs - Lists the background jobs.
+ * @info: Structure containing potential arguments.
+ *
+ * Description: Finished jobs are reported once and then forgotten.
+ *
+ * Return: Always returns 0, which info->status is set to.
+ */
+int shell_jobs(shell_info *info)
+{
+    job_t *job, *next;
+
+    for (job = info->jobs; job; job = next)
+    {
+        next = job->next;
+        printJob(job);
+        if (job->state == JOB_DONE)
+            removeJob(info, job);
+    }
+    return (info->status = 0);
+}
+
+/**
+ * shell_wait - Waits for background jobs to finish.
+ * @info: Structure containing potential arguments.
+ *
+ * Description: Without arguments every job is waited for and the status
+ * is 0. Otherwise each argument is a job spec ("%n") or a pid and the
+ * status is the one of the last job.
+ *
+ * Return: The exit status, 127 if a job does not exist.
+ */
+int shell_wait(shell_info *info)
+{
+    job_t *job;
+    int i, status = 0;
+
+    if (info->argc == 1)
+    {
+        while (info->jobs)
+        {
+            waitJob(info->jobs);
+            removeJob(info, info->jobs);
+        }
+        return (info->status = 0);
+    }
+
+    for (i = 1; info->argv[i]; i++)
+    {
+        job = findJob(info, info->argv[i]);
+        if (!job)
+        {
+            print_error(info, info->argv[i]);
+            _eputs(": no such job\n");
+            status = 127;
+            continue;
+        }
+        status = waitJob(job);
+        if (job->state == JOB_DONE)
+            removeJob(info, job);
+    }
+    return (info->status = status);
+}
+
+/**
+ * shell_fg - Moves a background job to the foreground.
+ * @info: Structure containing potential arguments.
+ *
+ * Return: The exit status of the job, 1 if there is no such job.
+ */
+int shell_fg(shell_info *info)
+{
+    job_t *job = findJob(info, info->argv[1]);
+
+    if (!job)
+    {
+        print_error(info, "no such job\n");
+        return (info->status = 1);
+    }
+
+    _puts(job->cmd);
+    _putchar('\n');
+    _putchar(BUF_FLUSH);
+    if (job->state == JOB_STOPPED && kill(job->pid, SIGCONT) == 0)
+        job->state = JOB_RUNNING;
+
+    info->status = waitJob(job);
+    if (job->state == JOB_DONE)
+        removeJob(info, job);
+    else
+        printJob(job);
+    return (info->status);
+}
+
+/**
+ * shell_bg - Resumes a stopped job in the background.
+ * @info: Structure containing potential arguments.
+ *
+ * Return: 0 on success, 1 if there is no such job; info->status is set
+ *         to it.
+ */
+int shell_bg(shell_info *info)
+{
+    job_t *job = findJob(info, info->argv[1]);
+
+    if (!job || job->state == JOB_DONE)
+    {
+        print_error(info, "no such job\n");
+        return (info->status = 1);
+    }
+
+    if (job->state == JOB_STOPPED && kill(job->pid, SIGCONT) == 0)
+        job->state = JOB_RUNNING;
+    _putchar('[');
+    _puts(convert_number(job->id, 10, 0));
+    _puts("] ");
+    _puts(job->cmd);
+    _puts(" &\n");
+    return (info->status = 0);
+}
@@ -0,0 +1,171 @@
+#include "shell.h"
+#include <sys/syscall.h>
+#include <time.h>
+
+/**
+ * parseDuration - Parses a duration such as "3", "0.25", "1.5m" or "2h".
+ * @str: The duration; the optional suffix is s, m, h or d (seconds by
+ *       default) and up to three fractional digits are honoured.
+ *
+ * Return: The duration in milliseconds, or -1 if str is not a duration.
+ */
+long parseDuration(char *str)
+{
+    long whole = 0, frac = 0, scale = 1000, unit = 1000;
+    char *c = str;
+
+    if (!str)
+        return (-1);
+    for (; *c >= '0' && *c <= '9'; c++)
+        whole = whole * 10 + (*c - '0');
+    if (*c == '.')
+        for (c++; *c >= '0' && *c <= '9'; c++)
+            if (scale > 1)
+                scale /= 10, frac += (*c - '0') * scale;
+    if (c == str || (*c && c[1]))
+        return (-1);
+    if (*c == 'm')
+        unit = 60000;
+    else if (*c == 'h')
+        unit = 3600000;
+    else if (*c == 'd')
+        unit = 86400000;
+    else if (*c && *c != 's')
+        return (-1);
+    return (whole * unit + frac * unit / 1000);
+}
+
+/**
+ * waitDeadline - Waits until a child exits or a deadline passes.
+ * @pidfd: The pidfd of the child.
+ * @timeout_ms: The time limit in milliseconds.
+ *
+ * Description: The pidfd becomes readable when the child exits, so a
+ * single poll() covers the whole wait; the remaining time is recomputed
+ * from CLOCK_MONOTONIC if a signal interrupts it.
+ *
+ * Return: 1 if the child exited, 0 on timeout, -1 on error.
+ */
+int waitDeadline(int pidfd, long timeout_ms)
+{
+    struct pollfd pfd;
+    struct timespec now, end;
+    long left = timeout_ms;
+    int ret;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    end.tv_sec += timeout_ms / 1000;
+    end.tv_nsec += (timeout_ms % 1000) * 1000000;
+    pfd.fd = pidfd;
+    pfd.events = POLLIN;
+    while (1)
+    {
+        ret = poll(&pfd, 1, left > INT_MAX ? INT_MAX : (int)left);
+        if (ret != 0 && !(ret == -1 && errno == EINTR))
+            return (ret > 0 ? 1 : -1);
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        left = (end.tv_sec - now.tv_sec) * 1000 +
+            (end.tv_nsec - now.tv_nsec) / 1000000;
+        if (left <= 0)
+            return (0);
+    }
+}
+
+/**
+ * waitChildDeadline - Waits until a child exits or a deadline passes,
+ *                     without a pidfd.
+ * @pid: The child.
+ * @timeout_ms: The time limit in milliseconds.
+ *
+ * Description: SIGCHLD is blocked and taken with sigtimedwait(); the
+ * child is checked with WNOWAIT so that waitCmd() still reaps it. A
+ * SIGCHLD taken here is raised again once it is unblocked, so that
+ * background jobs that ended meanwhile are still noticed.
+ *
+ * Return: 1 if the child exited, 0 on timeout, -1 on error.
+ */
+int waitChildDeadline(pid_t pid, long timeout_ms)
+{
+    struct timespec now, end, left;
+    sigset_t chld, old;
+    siginfo_t si;
+    long ms;
+    int ret, got = 0;
+
+    sigemptyset(&chld);
+    sigaddset(&chld, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &chld, &old);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    end.tv_sec += timeout_ms / 1000;
+    end.tv_nsec += (timeout_ms % 1000) * 1000000;
+    while (1)
+    {
+        si.si_pid = 0;
+        ret = waitid(P_PID, pid, &si, WEXITED | WNOHANG | WNOWAIT);
+        if (ret == -1 || si.si_pid == pid)
+            break;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        ms = (end.tv_sec - now.tv_sec) * 1000 +
+            (end.tv_nsec - now.tv_nsec) / 1000000;
+        if (ms <= 0)
+            break;
+        left.tv_sec = ms / 1000;
+        left.tv_nsec = ms % 1000 * 1000000;
+        got |= sigtimedwait(&chld, NULL, &left) == SIGCHLD;
+    }
+    sigprocmask(SIG_SETMASK, &old, NULL);
+    if (got)
+        raise(SIGCHLD);
+    return (ret == -1 ? -1 : si.si_pid == pid);
+}
+
+/**
+ * shell_timeout - Runs a command with a time limit.
+ * @info: Structure containing potential arguments.
+ *
+ * Description: "timeout DURATION command [arg...]" sends SIGTERM through
+ * the pidfd when the limit passes, or with kill() if the kernel gives no
+ * pidfd. A duration of 0 disables the limit.
+ *
+ * Return: The status of the command, 124 if it timed out, 125 on usage
+ *         errors and 126/127 if it could not be run.
+ */
+int shell_timeout(shell_info *info)
+{
+    long timeout_ms = info->argc > 2 ? parseDuration(info->argv[1]) : -1;
+    char *path;
+    pid_t pid;
+    int pidfd, expired, sent = -1;
+
+    if (timeout_ms < 0)
+    {
+        _eputs("timeout: usage: timeout DURATION command [arg...]\n");
+        return (info->status = 125);
+    }
+    path = resolveCmd(info, info->argv[2]);
+    if (!path && isCmd(info, info->argv[2]))
+        path = info->argv[2];
+    pid = path ? spawnProcess(info, path, info->argv + 2, NULL) : -1;
+    if (pid == -1)
+    {
+        info->status = (path && errno == EACCES) ? 126 : 127;
+        print_error(info, info->argv[2]);
+        _eputs(info->status == 126 ? ": Permission denied\n" : ": not found\n");
+        return (info->status);
+    }
+
+    pidfd = pidfdOpen(pid);
+    expired = timeout_ms > 0 && (pidfd >= 0 ?
+            waitDeadline(pidfd, timeout_ms) :
+            waitChildDeadline(pid, timeout_ms)) == 0;
+#ifdef SYS_pidfd_send_signal
+    if (expired && pidfd >= 0)
+        sent = syscall(SYS_pidfd_send_signal, pidfd, SIGTERM, NULL, 0);
+#endif
+    if (expired && sent == -1)
+        kill(pid, SIGTERM);
+    waitCmd(info, pid, pidfd);
+    if (expired)
+        info->status = 124;
+    return (info->status);
+}
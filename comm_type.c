@@ -0,0 +1,125 @@
+#include "shell.h"
+
+/**
+ * printDescription - Prints "name is <what>" or just the short form.
+ * @name: The command name.
+ * @what: The long description, e.g. "a shell builtin".
+ * @brief: The short form printed by "command -v".
+ * @verbose: If true the long form is printed.
+ *
+ * Return: Always 0.
+ */
+int printDescription(char *name, char *what, char *brief, int verbose)
+{
+    if (verbose)
+    {
+        _puts(name);
+        _puts(" is ");
+        _puts(what);
+    }
+    else
+        _puts(brief);
+    _putchar('\n');
+    return (0);
+}
+
+/**
+ * describeCmd - Reports how a name would be run.
+ * @info: The parameter struct.
+ * @name: The command name.
+ * @verbose: 1 for the "type" / "command -V" wording, 0 for "command -v".
+ *
+ * Description: Aliases are checked first, then builtins, then the
+ * command hash table and finally PATH, the same order used to run it.
+ *
+ * Return: 0 if the name was found, 1 otherwise.
+ */
+int describeCmd(shell_info *info, char *name, int verbose)
+{
+    list_t *node = nodeStartsWith(info->alias, name, '=');
+    char *path;
+
+    if (node)
+    {
+        path = _strchr(node->str, '=') + 1;
+        if (!verbose)
+            return (_puts("alias "), printAlias(node));
+        _puts(name);
+        _puts(" is aliased to `");
+        _puts(path);
+        _puts("'\n");
+        return (0);
+    }
+    if (getBuiltin(name))
+        return (printDescription(name, "a shell builtin", name, verbose));
+    node = hashFind(info, name);
+    if (node)
+    {
+        path = _strchr(node->str, '=') + 1;
+        if (verbose)
+            _puts(name), _puts(" is hashed ("), _puts(path), _puts(")\n");
+        else
+            _puts(path), _putchar('\n');
+        return (0);
+    }
+    path = findPath(info, getEnvironment(info, "PATH="), name);
+    if (!path && _strchr(name, '/') && isCmd(info, name))
+        path = name;
+    if (path)
+        return (printDescription(name, path, path, verbose));
+    if (verbose)
+        _eputs(info->argv[0]), _eputs(": "), _eputs(name),
+            _eputs(": not found\n");
+    return (1);
+}
+
+/**
+ * shell_type - Mimics the type builtin command.
+ * @info: Structure containing potential arguments.
+ *
+ * Return: 0 if every name was found, 1 otherwise.
+ */
+int shell_type(shell_info *info)
+{
+    int i, ret = 0;
+
+    for (i = 1; info->argv[i]; i++)
+        ret |= describeCmd(info, info->argv[i], 1);
+    return (info->status = ret);
+}
+
+/**
+ * shell_command - Mimics the command builtin.
+ * @info: Structure containing potential arguments.
+ *
+ * Description: "command -v name..." and "command -V name..." describe
+ * names like type. "command name [args]" runs name without alias
+ * expansion.
+ *
+ * Return: The status of the command, or -2 if it was exit.
+ */
+int shell_command(shell_info *info)
+{
+    int i, ret = 0;
+
+    if (info->argc < 2)
+        return (0);
+    if (!_strcmp(info->argv[1], "-v") || !_strcmp(info->argv[1], "-V"))
+    {
+        for (i = 2; info->argv[i]; i++)
+            ret |= describeCmd(info, info->argv[i], info->argv[1][1] == 'V');
+        return (info->status = ret);
+    }
+
+    freeArg(info, info->argv[0]);
+    for (i = 0; info->argv[i]; i++)
+        info->argv[i] = info->argv[i + 1];
+    info->argc--;
+    ret = findBuiltin(info);
+    if (ret == -1)
+    {
+        findCmd(info);
+        ret = info->status;
+    }
+    return (ret);
+}
@@ -14,7 +14,7 @@
 char **get_environ(shell_info *info)
 {
     /* Check if environment needs to be updated */
-    if (info->env_changed)
+    if (!info->environ || info->env_changed)
     {
         /* Free the old environment array if it exists */
         if (info->environ)
@@ -66,6 +66,9 @@ int unsetEnvironment(shell_info *info, char *var)
     }
 
     info->env_changed = env_changed;
+    info->state_gen += env_changed;
+    if (env_changed && _strcmp(var, "PATH") == 0)
+        hashClear(info, 0);
     return env_changed;
 }
 
@@ -100,6 +103,10 @@ int setEnvironment(shell_info *info, char *var, char *value)
     _strcat(new_env_entry, "=");
     _strcat(new_env_entry, value);
 
+    info->state_gen++;
+    if (_strcmp(var, "PATH") == 0)
+        hashClear(info, 0);
+
     for (node = info->env; node; node = node->next)
     {
         if (starts_with(node->str, var) && node->str[var_len] == '=')
@@ -112,6 +119,7 @@ int setEnvironment(shell_info *info, char *var, char *value)
     }
 
     append_node(&(info->env), new_env_entry, 0);
+    free(new_env_entry);
     info->env_changed = 1;
     return (0);
 }
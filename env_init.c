@@ -31,7 +31,8 @@ int shellEnvironment(shell_info *info)
  * @name: The name of the environment variable.
  *
  * Description: Searches the environment list for the specified variable
- * name and returns its value.
+ * name and returns its value. The name may be given with or without its
+ * trailing '=' ("PATH=" and "PATH" both work).
  *
  * Return: Pointer to the value of the environment variable, or NULL if not found.
  */
@@ -46,12 +47,16 @@ char *getEnvironment(shell_info *info, const char *name)
 
     node = info->env;
     name_len = _strlen(name);
+    if (!name_len)
+        return (NULL);
 
     while (node)
     {
         value_start = starts_with(node->str, name);
-        if (value_start && value_start[name_len] == '=')
-            return (value_start + name_len + 1);
+        if (value_start && name[name_len - 1] == '=')
+            return (value_start);
+        if (value_start && *value_start == '=')
+            return (value_start + 1);
 
         node = node->next;
     }
@@ -29,7 +29,7 @@ int _buffered_err_putchar(char c)
     static int i = 0;
     static char buf[WRITE_BUF_SIZE];
 
-    if (c == BUF_FLUSH || i >= WRITE_BUF_SIZE)
+    if ((c == BUF_FLUSH || i >= WRITE_BUF_SIZE) && i)
     {
         ssize_t written = write(2, buf, i);
         if (written == -1)
@@ -0,0 +1,199 @@
+#include "shell.h"
+
+/**
+ * runLine - Runs the syntax tree of the line read last.
+ * @info: The parameter & return info struct.
+ * @av: The argument vector from main().
+ *
+ * Description: The whole line is measured for the time keyword, except a
+ * bare "time", which reports the line before it. The time and the status
+ * are recorded on the line's history entry.
+ *
+ * Return: -2 if the exit builtin ran, otherwise the return value of the
+ *         last command run (-1 for external commands).
+ */
+int runLine(shell_info *info, char **av)
+{
+    ast_node_t *root;
+    int ret, measured;
+
+    if (info->root < 0)
+        return (0);
+    root = info->ast + info->root;
+    measured = root->type != AST_TIME || root->left >= 0;
+    if (measured)
+        startTiming(info);
+    ret = execNode(info, av, info->root);
+    if (measured)
+        stopTiming(info);
+    historyResult(info, measured ? info->usage.real : -1);
+    return (ret);
+}
+
+/**
+ * execNode - Runs a node of the syntax tree.
+ * @info: The parameter & return info struct.
+ * @av: The argument vector from main().
+ * @n: Index of the node in info->ast.
+ *
+ * Description: The right side of && runs only if the left side
+ * succeeded, that of || only if it failed. Nothing runs after exit.
+ *
+ * Return: -2 if the exit builtin ran, otherwise the return value of the
+ *         last command run.
+ */
+int execNode(shell_info *info, char **av, int n)
+{
+    ast_node_t *node = info->ast + n;
+    int ret;
+
+    switch (node->type)
+    {
+    case AST_SEQ:
+        ret = execNode(info, av, node->left);
+        return (ret == -2 ? ret : execNode(info, av, node->right));
+    case AST_AND:
+    case AST_OR:
+        ret = execNode(info, av, node->left);
+        if (ret == -2 || (node->type == AST_AND) == (info->status != 0))
+            return (ret);
+        return (execNode(info, av, node->right));
+    case AST_NOT:
+        ret = execNode(info, av, node->left);
+        info->status = !info->status;
+        return (ret);
+    case AST_BG:
+        runBackground(info, av, node->left);
+        return (0);
+    case AST_PIPE:
+        runPipeline(info, av, n);
+        return (0);
+    default:
+        return (runCommand(info, av, n));
+    }
+}
+
+/**
+ * runCommand - Runs a simple command, a subshell, a group or "time".
+ * @info: The parameter & return info struct.
+ * @av: The argument vector from main().
+ * @n: Index of the node in info->ast.
+ *
+ * Description: The argv and redirections of a simple command are freed
+ * once it is done, so the next command of the line starts clean.
+ *
+ * Return: -2 if the exit builtin ran, otherwise the return value of the
+ *         last command run.
+ */
+int runCommand(shell_info *info, char **av, int n)
+{
+    ast_node_t *node = info->ast + n;
+    pid_t pid;
+    int ret;
+
+    switch (node->type)
+    {
+    case AST_TIME:
+        if (node->left < 0)
+            return (stopTiming(info), printUsage(info), 0);
+        startTiming(info);
+        ret = execNode(info, av, node->left);
+        stopTiming(info);
+        printUsage(info);
+        return (ret);
+    case AST_GROUP:
+        return (runGroup(info, av, n));
+    case AST_SUBSHELL:
+        pid = forkNode(info, av, n, -1, -1);
+        if (pid > 0)
+            waitCmd(info, pid, pidfdOpen(pid));
+        return (0);
+    default:
+        ret = runSimpleCmd(info, av, n);
+        freeArgv(info);
+        freeRedirections(info);
+        info->path = NULL;
+        return (ret);
+    }
+}
+
+/**
+ * runGroup - Runs the list of a group or subshell with its redirections.
+ * @info: The parameter & return info struct.
+ * @av: The argument vector from main().
+ * @n: Index of the AST_GROUP or AST_SUBSHELL node.
+ *
+ * Description: The redirections are installed on the shell's own
+ * descriptors around the list, as for a redirected builtin, and taken
+ * out of info->redirs so the commands of the list can use it.
+ *
+ * Return: -2 if the exit builtin ran, otherwise the return value of the
+ *         last command run.
+ */
+int runGroup(shell_info *info, char **av, int n)
+{
+    ast_node_t *node = info->ast + n;
+    redir_t *redirs;
+    int ret;
+
+    setArgv(info, node->right, node->tok + node->ntok - node->right);
+    freeArgv(info);
+    if (prepareRedirections(info) == -1)
+        return (freeRedirections(info), 0);
+
+    redirs = info->redirs;
+    info->redirs = NULL;
+    redirectShell(redirs);
+    ret = execNode(info, av, node->left);
+    _putchar(BUF_FLUSH);
+    _buffered_err_putchar(BUF_FLUSH);
+    restoreRedirections(redirs);
+    info->redirs = redirs;
+    freeRedirections(info);
+    return (ret);
+}
+
+/**
+ * forkNode - Runs a node in a forked copy of the shell.
+ * @info: The parameter & return info struct.
+ * @av: The argument vector from main().
+ * @n: Index of the node: a subshell, or a group or list that has to run
+ *     as a pipeline stage or a background job.
+ * @in_fd: Descriptor to install as stdin, or -1.
+ * @out_fd: Descriptor to install as stdout, or -1.
+ *
+ * Description: The child exits with the status of the node, or with the
+ * code given to exit. It starts with no jobs and its own SIGCHLD pipe:
+ * the jobs of the parent are not its children to wait for.
+ *
+ * Return: The pid of the child, or -1 if fork() failed.
+ */
+pid_t forkNode(shell_info *info, char **av, int n, int in_fd, int out_fd)
+{
+    int type = info->ast[n].type, ret;
+    pid_t pid;
+
+    _putchar(BUF_FLUSH);
+    _buffered_err_putchar(BUF_FLUSH);
+    pid = fork();
+    if (pid == -1)
+        return (perror("Error:"), info->status = 1, -1);
+    if (pid)
+        return (pid);
+
+    freeJobs(info);
+    initJobs();
+    if (in_fd != -1)
+        dup2(in_fd, STDIN_FILENO), close(in_fd);
+    if (out_fd != -1)
+        dup2(out_fd, STDOUT_FILENO), close(out_fd);
+    if (type == AST_SUBSHELL || type == AST_GROUP)
+        ret = runGroup(info, av, n);
+    else
+        ret = execNode(info, av, n);
+    if (ret == -2 && info->err_num != -1)
+        info->status = info->err_num;
+    _putchar(BUF_FLUSH);
+    _buffered_err_putchar(BUF_FLUSH);
+    _exit(info->status);
+}
@@ -0,0 +1,180 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * expandWord - Expands the parameters of a word and removes its quotes.
+ * @info: The parameter struct.
+ * @word: The word as written, with its quotes.
+ *
+ * Description: Single quotes keep everything literal. Inside double
+ * quotes parameters are expanded and a backslash only protects $, `, ",
+ * \ and newline; elsewhere it protects any character, and a backslash
+ * before a newline disappears. The result is not split into fields.
+ * Words without quotes, backslashes or '$' are returned as they are, so
+ * they stay views into the line.
+ *
+ * Return: The word itself, an allocated string, or NULL on failure.
+ */
+char *expandWord(shell_info *info, char *word)
+{
+    char *buf, *c, *value;
+    size_t len = 0;
+    int dquote = 0;
+
+    if (!strpbrk(word, "'\"\\$"))
+        return (word);
+    buf = malloc(_strlen(word) + 1);
+    for (c = word; buf && *c;)
+    {
+        if (*c == '\'' && !dquote)
+        {
+            for (c++; *c && *c != '\'';)
+                buf[len++] = *c++;
+            c += *c == '\'';
+        }
+        else if (*c == '"')
+            dquote = !dquote, c++;
+        else if (*c == '\\' && c[1] && (!dquote || is_delim(c[1], "$`\"\\\n")))
+        {
+            if (c[1] != '\n')
+                buf[len++] = c[1];
+            c += 2;
+        }
+        else if (*c == '$' && expandParam(info, &c, &value))
+            buf = appendValue(buf, &len, value, _strlen(c));
+        else
+            buf[len++] = *c++;
+    }
+    if (buf)
+        buf[len] = '\0';
+    return (buf);
+}
+
+/**
+ * expandParam - Expands the parameter named after a '$'.
+ * @info: The parameter struct.
+ * @c: Address of the position of the '$', moved past the parameter.
+ * @value: Set to the allocated value, NULL on allocation failure.
+ *
+ * Description: $NAME, ${NAME} and the one-character parameters $?, $$,
+ * $!, $0 to $9 are recognized; any other '$' is literal.
+ *
+ * Return: 1 if a parameter was expanded, 0 if the '$' is literal.
+ */
+int expandParam(shell_info *info, char **c, char **value)
+{
+    char *name = *c + 1;
+    int len = 0, braces = *name == '{';
+
+    name += braces;
+    if (*name && is_delim(*name, "?$!0123456789"))
+        len = 1;
+    else
+        while (name[len] == '_' || _isalpha(name[len]) ||
+                (len && name[len] >= '0' && name[len] <= '9'))
+            len++;
+    if (!len || (braces && name[len] != '}'))
+        return (0);
+
+    *c = name + len + braces;
+    *value = paramValue(info, name, len);
+    return (1);
+}
+
+/**
+ * paramValue - Looks up the value of a parameter.
+ * @info: The parameter struct.
+ * @name: The name, not NUL-terminated.
+ * @len: Length of the name.
+ *
+ * Description: Besides the special parameters, SECONDS and PIPESTATUS
+ * are computed by the shell; other names come from the environment and
+ * unset ones expand to nothing.
+ *
+ * Return: The allocated value, or NULL on failure.
+ */
+char *paramValue(shell_info *info, char *name, int len)
+{
+    list_t *node;
+
+    if (len == 1 && (*name == '?' || *name == '$'))
+        return (_strdup(convert_number(*name == '?' ? info->status :
+                        getpid(), 10, 0)));
+    if (len == 1 && *name == '!')
+        return (_strdup(info->last_bg_pid ?
+                    convert_number(info->last_bg_pid, 10, 0) : ""));
+    if (len == 1 && *name == '0')
+        return (_strdup(info->fname));
+    if (len == 7 && !strncmp(name, "SECONDS", len))
+        return (_strdup(convert_number(usecSince(&info->started) / 1000000,
+                        10, 0)));
+    if (len == 10 && !strncmp(name, "PIPESTATUS", len))
+        return (pipeStatusString(info));
+
+    for (node = info->env; node; node = node->next)
+        if (!strncmp(node->str, name, len) && node->str[len] == '=')
+            return (_strdup(node->str + len + 1));
+    return (_strdup(""));
+}
+
+/**
+ * appendValue - Appends the value of a parameter to a word being expanded.
+ * @buf: The word; it has room for len bytes and what is left of the
+ *       source word.
+ * @len: Address of the length of the word, advanced past the value.
+ * @value: The allocated value, freed here; NULL appends nothing.
+ * @rest: Number of bytes left in the source word.
+ *
+ * Return: The grown buffer, or NULL on failure (buf is freed).
+ */
+char *appendValue(char *buf, size_t *len, char *value, size_t rest)
+{
+    size_t size = value ? _strlen(value) : 0;
+    char *grown = realloc(buf, *len + size + rest + 1);
+
+    if (!grown)
+        free(buf);
+    else if (value)
+    {
+        memcpy(grown + *len, value, size);
+        *len += size;
+    }
+    free(value);
+    return (grown);
+}
+
+/**
+ * replace_alias - Replaces an alias at the start of the command
+ * @info: The parameter struct containing shell information
+ *
+ * Description: If argv[0] names an alias, it is replaced with the words
+ * of the alias's value, so "alias ll='ls -l'" runs ls with -l.
+ *
+ * Return: 1 if an alias is replaced, 0 otherwise
+ */
+int replace_alias(shell_info *info)
+{
+    list_t *node = nodeStartsWith(info->alias, info->argv[0], '=');
+    char **words, **argv;
+    int n;
+
+    if (!node)
+        return (0);
+    words = strtow(_strchr(node->str, '=') + 1, " \t");
+    if (!words)
+        return (0);
+    for (n = 0; words[n]; n++)
+        ;
+    argv = malloc(sizeof(char *) * (n + info->argc));
+    if (!argv)
+        return (ffree(words), 0);
+
+    memcpy(argv, words, sizeof(char *) * n);
+    memcpy(argv + n, info->argv + 1, sizeof(char *) * info->argc);
+    freeArg(info, info->argv[0]);
+    free(info->argv);
+    free(words);
+    info->argv = argv;
+    info->argc += n - 1;
+    return (1);
+}
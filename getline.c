@@ -1,27 +1,28 @@
-#include <signal.h>
 #include "shell.h"
+#include <signal.h>
 #include <stdlib.h>
 
 /**
- * load_input_to_buffer - Buffers chained commands.
+ * load_input_to_buffer - Reads and parses the next command line of input.
  * @info: Parameter struct containing shell information.
  * @buf: Address of the buffer.
- * @len: Address of the length variable.
  *
- * Return: Number of bytes read.
+ * Description: A line that ends inside quotes, a group or after an
+ * operator is continued with the lines that follow it. The buffer is
+ * kept from line to line and only grows; a line of a mapped script is
+ * a slice of the mapping instead. A line read ahead is ready to run.
+ * At a terminal, SEARCH_KEY starts a reverse search of the history.
+ *
+ * Return: Number of bytes read, or -1 on EOF.
  */
-ssize_t load_input_to_buffer(shell_info *info, char **buf, size_t *len)
+ssize_t load_input_to_buffer(shell_info *info, char **buf)
 {
+    static size_t buffer_length;
     ssize_t bytes_read = 0;
-    size_t buffer_length = 0;
+    char *line;
+    int parsed;
 
-    /* Return immediately if the buffer still has data */
-    if (*len > 0)
-        return bytes_read;
-
-    /* Free and reset the buffer */
-    free(*buf);
-    *buf = NULL;
+    freeHeredocs(info);
 
     /* Set signal handler for SIGINT */
     signal(SIGINT, handle_ctrl_c_signal);
@@ -30,7 +31,24 @@ ssize_t load_input_to_buffer(shell_info *info, char **buf, size_t *len)
 #if USE_GETLINE
     bytes_read = getline(buf, &buffer_length, stdin);
 #else
-    bytes_read = custom_getline(info, buf, &buffer_length);
+    if (takePrefetch(info, buf) != -1)
+        return (buffer_length = _strlen(*buf) + 1);
+    if (info->input_map)
+    {
+        freeLine(info, *buf);
+        *buf = NULL;
+        buffer_length = 0;
+        bytes_read = mapLine(info, buf, 0);
+    }
+    else
+    {
+        searchKey(info, 1);
+        bytes_read = custom_getline(info, buf, &buffer_length);
+        if (bytes_read > 0 && (*buf)[bytes_read - 1] == SEARCH_KEY &&
+                info->search.key)
+            bytes_read = searchHistory(info, buf, &buffer_length, bytes_read);
+        searchKey(info, 0);
+    }
 #endif
 
     /* Process input if any data is read */
@@ -38,103 +56,90 @@ ssize_t load_input_to_buffer(shell_info *info, char **buf, size_t *len)
     {
         /* Check and remove trailing newline */
         if ((*buf)[bytes_read - 1] == '\n')
-        {
             (*buf)[bytes_read - 1] = '\0';
-            bytes_read--;
-        }
-
-        /* Set flags and process the buffer */
-        info->linecount_flag = 1;
-        remove_comments(*buf);
-        append_to_history(info, *buf, info->histcount++);
 
-        /* Check for command chain and update info */
-        if (_strchr(*buf, ';'))
-        {
-            *len = bytes_read;
-            info->cmd_buf = buf;
-        }
+        /* Parse the line, reading more while it is incomplete */
+        info->line_count++;
+        line = *buf;
+        parsed = parseLine(info, *buf);
+        while (parsed == PARSE_INCOMPLETE && continueLine(info, buf) == 0)
+            parsed = parseLine(info, *buf);
+        if (*buf != line)
+            buffer_length = _strlen(*buf) + 1;
+        append_to_history(info, *buf);
+        if (parsed == PARSE_OK)
+            finishTokens(info);
     }
 
-    return bytes_read;
+    return (bytes_read);
 }
 
-
-
 /**
- * retrieve_input_line - Gets a line minus the newline, handling command chains.
+ * retrieve_input_line - Gets and parses the next command line of input.
  * @info: Parameter struct containing shell information.
  *
+ * Description: info->root is set to the syntax tree of the line, -1 for
+ * a blank line or one with a syntax error; info->arg is the line the
+ * tokens point into. A compiled script hands out its lines ready-made.
+ *
  * Return: Number of bytes read, or -1 on EOF.
  */
 ssize_t retrieve_input_line(shell_info *info)
 {
-    static char *buf; /* Command chain buffer */
-    static size_t buf_pos = 0, chain_pos = 0, buf_len = 0;
+    static char *buf; /* The current line, shared by its commands */
     ssize_t bytes_read = 0;
-    char **current_cmd = &(info->arg), *cmd_start;
 
     _putchar(BUF_FLUSH);
-    bytes_read = load_input_to_buffer(info, &buf, &buf_len);
-
-    if (bytes_read == -1) /* EOF handling */
-        return (-1);
-
-    if (buf_len) /* Commands left in the chain buffer */
-    {
-        chain_pos = buf_pos; /* Initialize new iterator to current buffer position */
-        cmd_start = buf + buf_pos; /* Get pointer to the current command */
-
-        check_chain(info, buf, &chain_pos, buf_pos, buf_len);
-
-        /* Iterate to semicolon or end of buffer */
-        while (chain_pos < buf_len)
-        {
-            if (checkCommandChain(info, buf, &chain_pos))
-                break;
-            chain_pos++;
-        }
-
-        buf_pos = chain_pos + 1; /* Increment past the nullified semicolon */
-
-        if (buf_pos >= buf_len) /* Check if end of buffer is reached */
-        {
-            buf_pos = buf_len = 0; /* Reset buffer position and length */
-            info->cmd_buf_type = CMD_NORM;
-        }
-
-        *current_cmd = cmd_start; /* Pass back pointer to the current command */
-        return (_strlen(cmd_start)); /* Return the length of the current command */
-    }
-
-    *current_cmd = buf; /* Pass back the buffer from load_input_to_buffer */
-    return (bytes_read); /* Return the length from load_input_to_buffer */
+    if (info->script)
+        return (scriptLine(info));
+    bytes_read = load_input_to_buffer(info, &buf);
+    info->cmd_buf = &buf;
+    return (bytes_read);
 }
 
 /**
- * read_data_to_buffer - Reads data into a buffer from a file descriptor.
- * @info: Parameter struct containing the file descriptor to read from.
- * @buf: Buffer where the data will be stored.
- * @bytes_read: Pointer to the size variable, updated with the number of bytes read.
+ * read_data_to_buffer - Refills the input buffer once it is used up.
+ * @info: Parameter struct holding the input descriptor and buffer.
+ *
+ * Description: The buffer starts at READ_BUF_SIZE for a terminal and
+ * INPUT_BUF_SIZE otherwise. When the last two reads together got more
+ * than half of it, lines arrive faster than they are run, as when
+ * commands are piped in, and it is doubled for the next read, up to
+ * INPUT_BUF_MAX; a pipe rarely fills it in one read. When they got less
+ * than an eighth, it is halved again, down to INPUT_BUF_SIZE.
  *
- * Return: The number of bytes read, or -1 on error.
+ * Return: Number of bytes waiting in the buffer, 0 at EOF, -1 on error.
  */
-ssize_t read_data_to_buffer(shell_info *info, char *buf, size_t *bytes_read)
+ssize_t read_data_to_buffer(shell_info *info)
 {
-    ssize_t read_result = 0;
-
-    /* Check if the buffer already has data */
-    if (*bytes_read)
-        return 0;
-
-    /* Read data into the buffer */
-    read_result = read(info->readfd, buf, READ_BUF_SIZE);
-
-    /* Update the bytes_read if read operation was successful */
-    if (read_result >= 0)
-        *bytes_read = read_result;
+    input_buf_t *in = &info->input;
+    size_t want = in->size;
+    ssize_t got;
+    char *grown;
+
+    if (in->pos < in->len)
+        return (in->len - in->pos);
+    if (!want)
+        want = isatty(info->readfd) ? READ_BUF_SIZE : INPUT_BUF_SIZE;
+    else if (in->last + in->len > in->size / 2 && in->size < INPUT_BUF_MAX)
+        want = in->size * 2;
+    else if (in->last + in->len < in->size / 8 && in->size > INPUT_BUF_SIZE)
+        want = in->size / 2;
+    in->last = in->len;
+    in->pos = in->len = 0;
+    if (want != in->size)
+    {
+        grown = realloc(in->data, want);
+        if (grown)
+            in->data = grown, in->size = want;
+    }
+    if (!in->data)
+        return (-1);
 
-    return read_result;
+    got = read(info->readfd, in->data, in->size);
+    if (got > 0)
+        in->len = got;
+    return (got);
 }
 
 
@@ -142,47 +147,56 @@ ssize_t read_data_to_buffer(shell_info *info, char *buf, size_t *bytes_read)
  * custom_getline - Gets the next line of input from STDIN.
  * @info: Parameter struct containing read file descriptor.
  * @ptr: Address of the pointer to the buffer, preallocated or NULL.
- * @length: Size of preallocated buffer if not NULL, updated with new size.
+ * @length: Allocated size of *ptr if it is not NULL, updated when the
+ *          buffer grows; may be NULL.
+ *
+ * Description: The line is copied out of the input buffer, refilled
+ * until a newline or EOF so a line that crosses a refill is still
+ * returned whole; *ptr is reused when it is large enough. At a terminal
+ * set up by searchKey(), a line may also end with SEARCH_KEY. A mapped
+ * script is not read at all: the line is copied out of it.
  *
  * Return: The number of characters read, or -1 on error or EOF.
  */
 int custom_getline(shell_info *info, char **ptr, size_t *length)
 {
-    static char buf[READ_BUF_SIZE];
-    static size_t current_pos = 0, buf_len = 0;
-    size_t line_len;
-    ssize_t read_result = 0, total_chars = 0;
-    char *line_start = NULL, *new_buffer = NULL, *newline_char;
+    input_buf_t *in = &info->input;
+    size_t chunk, total = 0, cap = (*ptr && length) ? *length : 0;
+    char *line = cap ? *ptr : NULL, *newline_char = NULL, *grown;
 
-    line_start = *ptr;
-    if (line_start && length)
-        total_chars = *length;
-
-    if (current_pos == buf_len)
-        current_pos = buf_len = 0;
-
-    read_result = read_data_to_buffer(info, buf, &buf_len);
-    if (read_result == -1 || (read_result == 0 && buf_len == 0))
-        return (-1);
-
-    newline_char = _strchr(buf + current_pos, '\n');
-    line_len = newline_char ? (size_t)(1 + newline_char - buf) : buf_len;
-    new_buffer = reAllocate(line_start, total_chars, total_chars ? total_chars + line_len : line_len + 1);
-    if (!new_buffer)
-        return (line_start ? free(line_start), -1 : -1);
-
-    if (total_chars)
-        _strncat(new_buffer, buf + current_pos, line_len - current_pos);
-    else
-        _strncpy(new_buffer, buf + current_pos, line_len - current_pos + 1);
-
-    total_chars += line_len - current_pos;
-    current_pos = line_len;
-    *ptr = new_buffer;
+    if (info->input_map)
+    {
+        chunk = mapLine(info, ptr, 1);
+        if (length)
+            *length = chunk == (size_t)-1 ? 0 : chunk + 1;
+        return ((int)chunk);
+    }
+    while (!newline_char && read_data_to_buffer(info) > 0)
+    {
+        newline_char = memchr(in->data + in->pos, '\n', in->len - in->pos);
+        if (!newline_char && info->search.key &&
+                in->data[in->len - 1] == SEARCH_KEY)
+            newline_char = in->data + in->len - 1;
+        chunk = newline_char ? (size_t)(newline_char - in->data) + 1 - in->pos
+            : in->len - in->pos;
+        if (total + chunk + 1 > cap)
+        {
+            grown = realloc(line, (total + chunk + 1) * 2);
+            if (!grown)
+                return (free(line), *ptr = NULL, -1);
+            line = grown;
+            cap = (total + chunk + 1) * 2;
+        }
+        memcpy(line + total, in->data + in->pos, chunk);
+        line[total + chunk] = '\0';
+        total += chunk;
+        in->pos += chunk;
+    }
 
+    *ptr = line;
     if (length)
-        *length = total_chars;
-    return (total_chars);
+        *length = cap;
+    return (total ? (int)total : -1);
 }
 
 /**
@@ -51,14 +51,44 @@ int _isalpha(int c)
  */
 void prune_history(shell_info *info, int max_entries)
 {
-    list_t *current;
-    int count = 0;
+    /* Remove the oldest entries if the count exceeds max_entries */
+    while (info->history && info->history->count > max_entries)
+        historyEvict(info->history);
+}
 
-    /* Count the number of entries in the history */
-    for (current = info->history; current; current = current->next)
-        count++;
+/**
+ * histControl - Gives the history policies set in HISTCONTROL.
+ * @info: The parameter struct.
+ *
+ * Description: HISTCONTROL is a colon-separated list of ignorespace,
+ * ignoredups, ignoreboth and erasedups. It is only read again after the
+ * environment changed.
+ *
+ * Return: The HC_ flags of the policies.
+ */
+int histControl(shell_info *info)
+{
+    static char *names[] = {"ignorespace", "ignoredups", "erasedups",
+        "ignoreboth"};
+    static int flags[] = {HC_IGNORESPACE, HC_IGNOREDUPS, HC_ERASEDUPS,
+        HC_IGNORESPACE | HC_IGNOREDUPS};
+    char *word, *end;
+    int i;
 
-    /* Remove the oldest entries if the count exceeds max_entries */
-    while (count-- > max_entries)
-        remove_node_at(&(info->history), 0);
+    if (info->histcontrol_gen == info->state_gen + 1)
+        return (info->histcontrol);
+    info->histcontrol = 0;
+    info->histcontrol_gen = info->state_gen + 1;
+    for (word = getEnvironment(info, HISTCONTROL_VAR); word && *word;
+            word = *end ? end + 1 : end)
+    {
+        end = strchr(word, ':');
+        if (!end)
+            end = word + _strlen(word);
+        for (i = 0; i < 4; i++)
+            if ((size_t)(end - word) == (size_t)_strlen(names[i]) &&
+                    strncmp(word, names[i], end - word) == 0)
+                info->histcontrol |= flags[i];
+    }
+    return (info->histcontrol);
 }
@@ -0,0 +1,129 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <sys/mman.h>
+
+/**
+ * openHereFd - Creates the anonymous in-memory file behind a here-document.
+ *
+ * Description: The body lives in a memfd, so nothing touches the disk and
+ * no helper process has to feed a pipe; a body of any size can be written
+ * before the command starts without blocking.
+ *
+ * Return: The new descriptor (close-on-exec), or -1 on failure.
+ */
+int openHereFd(void)
+{
+    return (memfd_create("hsh-heredoc", MFD_CLOEXEC | MFD_ALLOW_SEALING));
+}
+
+/**
+ * hereWrite - Appends bytes to a here-document.
+ * @fd: The here-document memfd.
+ * @buf: The bytes to append.
+ * @len: The number of bytes.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int hereWrite(int fd, char *buf, size_t len)
+{
+    ssize_t n;
+
+    while (len > 0)
+    {
+        n = write(fd, buf, len);
+        if (n <= 0)
+            return (-1);
+        buf += n;
+        len -= n;
+    }
+    return (0);
+}
+
+/**
+ * sealHereFd - Freezes a finished here-document and rewinds it.
+ * @fd: The here-document memfd, closed on failure.
+ *
+ * Description: Once sealed the body can be neither written, grown nor
+ * shrunk, so the command reading it as stdin sees exactly what the
+ * script supplied.
+ *
+ * Return: fd ready to be used as stdin, or -1 on failure.
+ */
+int sealHereFd(int fd)
+{
+    if (fd < 0)
+        return (-1);
+    fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE |
+            F_SEAL_SEAL);
+    if (lseek(fd, 0, SEEK_SET) == -1)
+    {
+        close(fd);
+        return (-1);
+    }
+    return (fd);
+}
+
+/**
+ * readHeredoc - Reads the body of a here-document from the shell input.
+ * @info: The parameter struct holding the input descriptor.
+ * @delim: The line that ends the body.
+ * @strip_tabs: If on ("<<-"), leading tabs are removed from every line.
+ *
+ * Description: Lines come from custom_getline(), so a body larger than
+ * READ_BUF_SIZE is streamed into the memfd one line at a time.
+ *
+ * Return: The sealed memfd holding the body, or -1 on failure.
+ */
+int readHeredoc(shell_info *info, char *delim, int strip_tabs)
+{
+    int fd = openHereFd(), got;
+    size_t len;
+    char *line = NULL, *text;
+
+    while (fd >= 0)
+    {
+        if (interactive(info))
+        {
+            _puts("> ");
+            _putchar(BUF_FLUSH);
+        }
+        free(line);
+        line = NULL;
+        len = 0;
+        got = custom_getline(info, &line, &len);
+        if (got <= 0)
+            break;
+        info->line_count++;
+        for (text = line; strip_tabs && *text == '\t'; text++)
+            ;
+        if (line[got - 1] == '\n')
+            line[got - 1] = '\0';
+        if (!_strcmp(text, delim))
+            break;
+        if (line[got - 1] == '\0')
+            line[got - 1] = '\n';
+        if (hereWrite(fd, text, line + got - text) == -1)
+            close(fd), fd = -1;
+    }
+    free(line);
+    return (sealHereFd(fd));
+}
+
+/**
+ * hereString - Builds the stdin of a "<<<word" here-string.
+ * @word: The word; a newline is appended as in other shells.
+ *
+ * Return: The sealed memfd holding the word, or -1 on failure.
+ */
+int hereString(char *word)
+{
+    int fd = openHereFd();
+
+    if (fd >= 0 && (hereWrite(fd, word, _strlen(word)) == -1 ||
+                hereWrite(fd, "\n", 1) == -1))
+    {
+        close(fd);
+        fd = -1;
+    }
+    return (sealHereFd(fd));
+}
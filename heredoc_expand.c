@@ -0,0 +1,73 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * expandHereText - Expands the parameters of a here-document body.
+ * @info: The parameter struct.
+ * @text: The body.
+ *
+ * Description: As inside double quotes, but quotes are ordinary
+ * characters: a backslash only protects $, `, \ and newline, and a
+ * backslash before a newline disappears with it.
+ *
+ * Return: The allocated expanded body, or NULL on failure.
+ */
+char *expandHereText(shell_info *info, char *text)
+{
+    char *buf = malloc(_strlen(text) + 1), *c, *value;
+    size_t len = 0;
+
+    for (c = text; buf && *c;)
+    {
+        if (*c == '\\' && c[1] && is_delim(c[1], "$`\\\n"))
+        {
+            if (c[1] != '\n')
+                buf[len++] = c[1];
+            c += 2;
+        }
+        else if (*c == '$' && expandParam(info, &c, &value))
+            buf = appendValue(buf, &len, value, _strlen(c));
+        else
+            buf[len++] = *c++;
+    }
+    if (buf)
+        buf[len] = '\0';
+    return (buf);
+}
+
+/**
+ * expandHeredoc - Replaces a here-document by its expanded body.
+ * @info: The parameter struct.
+ * @fd: The sealed memfd holding the body as read, closed here.
+ *
+ * Description: The body is only expanded when its command runs, so $?
+ * and the variables it sees are those of that moment.
+ *
+ * Return: A new sealed memfd holding the expanded body, or -1 on
+ *         failure.
+ */
+int expandHeredoc(shell_info *info, int fd)
+{
+    char *body = NULL, *text = NULL;
+    struct stat st;
+    int out = -1;
+
+    if (fstat(fd, &st) == 0)
+        body = malloc(st.st_size + 1);
+    if (body && pread(fd, body, st.st_size, 0) == st.st_size)
+    {
+        body[st.st_size] = '\0';
+        text = expandHereText(info, body);
+    }
+    if (text)
+    {
+        out = openHereFd();
+        if (out != -1 && hereWrite(out, text, _strlen(text)) == -1)
+            close(out), out = -1;
+        out = sealHereFd(out);
+    }
+    close(fd);
+    free(body);
+    free(text);
+    return (out);
+}
@@ -0,0 +1,144 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * hereDelimiter - Gives the delimiter of a here-document.
+ * @word: The word token after "<<".
+ * @quoted: Set to 1 if any of the word is quoted, 0 otherwise.
+ *
+ * Description: Quotes and backslashes are removed. A body whose
+ * delimiter has none has its parameters expanded, see expandHeredoc();
+ * quoting any part of the delimiter keeps the body literal.
+ *
+ * Return: The allocated delimiter, or NULL on failure.
+ */
+char *hereDelimiter(token_t *word, int *quoted)
+{
+    char *delim = malloc(word->len + 1);
+    int i, len = 0;
+
+    *quoted = 0;
+    if (!delim)
+        return (NULL);
+    for (i = 0; i < word->len; i++)
+        if (!is_delim(word->word[i], "'\"\\"))
+            delim[len++] = word->word[i];
+        else
+            *quoted = 1;
+    delim[len] = '\0';
+    return (delim);
+}
+
+/**
+ * hasHeredoc - Checks whether a line has here-documents.
+ * @tok: The tokens of the line.
+ * @n: The number of tokens.
+ *
+ * Return: 1 if a "<<" or "<<-" is among them, 0 otherwise.
+ */
+int hasHeredoc(token_t *tok, int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+        if (tok[i].type == TOK_REDIR && starts_with(tok[i].word, "<<") &&
+                tok[i].word[2] != '<')
+            return (1);
+    return (0);
+}
+
+/**
+ * collectHeredocs - Reads the bodies of the here-documents of a line.
+ * @info: The parameter struct; a memfd per "<<" is queued in info->heredocs.
+ *
+ * Description: Bodies follow the line in the input, so they are consumed
+ * as soon as the line is lexed, before any command of it runs. Each "<<"
+ * token is numbered with the index of its body. A line that is continued
+ * is lexed again, and only the bodies not read yet are read then. "<<<"
+ * is a here-string and has no body. The node of a body to be expanded
+ * keeps its delimiter in str.
+ *
+ * Return: void
+ */
+void collectHeredocs(shell_info *info)
+{
+    token_t *tok = info->tokens;
+    int i, index = 0, done = listLen(info->heredocs), quoted;
+    char *delim;
+
+    for (i = 0; i < info->ntokens; i++)
+    {
+        if (tok[i].type != TOK_REDIR || !starts_with(tok[i].word, "<<") ||
+                tok[i].word[2] == '<')
+            continue;
+        tok[i].len = index++;
+        if (tok[i].len < done || i + 1 == info->ntokens ||
+                tok[i + 1].type != TOK_WORD)
+            continue;
+        delim = hereDelimiter(tok + i + 1, &quoted);
+        if (delim)
+            append_node(&(info->heredocs), quoted ? NULL : delim,
+                    readHeredoc(info, delim, tok[i].word[2] == '-'));
+        free(delim);
+    }
+}
+
+/**
+ * parseHereRedir - Fills in a "<<word" or "<<<word" redirection.
+ * @info: The parameter struct holding the queued here-documents.
+ * @redir: The redirection; its source becomes a sealed memfd it owns.
+ * @op: The "<<", "<<-" or "<<<" token.
+ * @word: The expanded word after it: the text of a here-string.
+ *
+ * Description: A here-document takes the body numbered in its token, so
+ * bodies of commands skipped by && or || do not shift the others. An
+ * unquoted body is expanded now, as the command runs, so parameters set
+ * earlier on its line are seen.
+ *
+ * Return: void
+ */
+void parseHereRedir(shell_info *info, redir_t *redir, token_t *op,
+        char *word)
+{
+    list_t *doc = info->heredocs;
+    int i;
+
+    redir->owned = 1;
+    if (op->word[2] == '<')
+    {
+        redir->src_fd = hereString(word);
+        return;
+    }
+
+    for (i = 0; doc && i < op->len; i++)
+        doc = doc->next;
+    if (doc)
+    {
+        redir->src_fd = doc->str && doc->num >= 0 ?
+            expandHeredoc(info, doc->num) : doc->num;
+        doc->num = -1;
+    }
+}
+
+/**
+ * freeHeredocs - Closes the here-documents no command has used.
+ * @info: The parameter struct.
+ *
+ * Description: Bodies of commands that did not run are left over.
+ *
+ * Return: void
+ */
+void freeHeredocs(shell_info *info)
+{
+    list_t *doc;
+
+    while (info->heredocs)
+    {
+        doc = info->heredocs;
+        info->heredocs = doc->next;
+        if (doc->num >= 0)
+            close(doc->num);
+        free(doc->str);
+        free(doc);
+    }
+}
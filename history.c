@@ -1,4 +1,5 @@
 #include "shell.h"
+#include <sys/file.h>
 
 /**
  * getHistoryFile - Gets the history file path.
@@ -27,36 +28,38 @@ char *getHistoryFile(shell_info *info)
 
 
 /**
- * save_command_history - Writes the shell's command history to a file.
+ * save_command_history - Compacts the history file at exit.
  * @info: The parameter struct containing history data.
  *
- * Return: 1 on successful write, -1 on failure.
+ * Description: Lines are appended to the file as they are read, see
+ * journalHistory(), so there is nothing left to write here; the file is
+ * only cut back to the lines in memory if it grew past HISTORY_MAX. A
+ * shared file is locked first and the lines of the other shells read
+ * in, so that they are kept. A binary snapshot of the history is then
+ * taken if the file holds no line the history does not.
+ *
+ * Return: 1 on success, -1 on failure.
  */
 int save_command_history(shell_info *info)
 {
-    int fd;
-    char *filename = getHistoryFile(info);
-    list_t *current_node;
-
-    if (!filename)
-        return (-1);
-
-    fd = open(filename, O_CREAT | O_TRUNC | O_RDWR, 0644);
-    free(filename);
-
-    if (fd == -1)
-        return (-1);
-
-    for (current_node = info->history; current_node; current_node = current_node->next)
-    {
-        _fd_puts(current_node->str, fd);
-        _buffered_fd_putchar('\n', fd);
-    }
-
-    _buffered_fd_putchar(BUF_FLUSH, fd);
-    close(fd);
+    int ret = 1, locked = lockJournal(info);
+    char *file = getHistoryFile(info);
+    struct stat st;
 
-    return 1;
+    if (info->hist_lines > HISTORY_MAX && info->history)
+        ret = compactHistory(info) == 0 ? 1 : -1;
+    if (file && info->history && info->hist_off != info->hist_snap &&
+            stat(file, &st) == 0 && st.st_ino == info->hist_ino &&
+            st.st_size == info->hist_off)
+        writeSnapshot(info, &st);
+    free(file);
+    if (locked && info->hist_fd >= 0)
+        flock(info->hist_fd, LOCK_UN);
+    if (info->hist_fd >= 0)
+        close(info->hist_fd);
+    info->hist_fd = -1;
+
+    return ret;
 }
 
 
@@ -64,16 +67,21 @@ int save_command_history(shell_info *info)
  * load_command_history - Reads the shell's command history from a file.
  * @info: The parameter struct containing history data.
  *
+ * Description: The binary snapshot of the history is loaded if it is
+ * up to date, see loadSnapshot(); only the lines appended to the file
+ * since are then read and split. Otherwise the whole file is.
+ *
  * Return: The number of history entries read on success, 0 otherwise.
  */
 int load_command_history(shell_info *info)
 {
     int fd, linecount = 0;
     ssize_t rdlen;
-    size_t fsize = 0;
+    long off;
     struct stat st;
     char *buf, *filename = getHistoryFile(info), *command_start;
-    size_t i;
+    history_t *h;
+    ssize_t i;
 
     if (!filename)
         return 0;
@@ -81,42 +89,44 @@ int load_command_history(shell_info *info)
     fd = open(filename, O_RDONLY);
     free(filename);
 
+    info->hist_share = getenv(SHARE_HISTORY_VAR) != NULL;
     if (fd == -1 || fstat(fd, &st))
         return close(fd), 0;
+    info->hist_ino = st.st_ino;
 
-    if (st.st_size < 0)
-        return close(fd), 0;
-
-    fsize = (size_t)st.st_size;
-    if (fsize < 2)
-        return close(fd), 0;
-
-    buf = malloc(fsize + 1);
-    if (!buf)
-        return 0;
-
-    rdlen = read(fd, buf, fsize);
+    off = loadSnapshot(info, &st);
+    buf = malloc(st.st_size - off + 1);
+    rdlen = buf ? pread(fd, buf, st.st_size - off, off) : -1;
     close(fd);
-
-    if (rdlen <= 0)
+    if (rdlen < 0)
         return free(buf), 0;
 
-    buf[fsize] = '\0';
-    for (i = 0, command_start = buf; i < fsize; i++)
+    buf[rdlen] = '\0';
+    if (off)
+        command_start = buf;
+    else
+        info->hist_seq = historyHeader(buf, &command_start);
+    for (i = command_start - buf; i < rdlen; i++)
     {
         if (buf[i] == '\n')
         {
             buf[i] = '\0';
-            append_to_history(info, command_start, linecount++);
+            if (historyKeep(info, command_start) && (h = historyRing(info)))
+                historyAdd(h, command_start, linecount);
+            linecount++;
             command_start = buf + i + 1;
         }
     }
 
-    if (command_start != buf + i)
-        append_to_history(info, command_start, linecount++);
+    if (command_start != buf + i && historyKeep(info, command_start) &&
+            (h = historyRing(info)))
+        historyAdd(h, command_start, linecount);
+    linecount += command_start != buf + i;
 
     free(buf);
-    info->histcount = linecount;
+    info->hist_lines += linecount;
+    info->hist_off = off + rdlen;
+    info->hist_seq += linecount;
     prune_history(info, HISTORY_MAX);
     renumberHistory(info);
 
@@ -126,44 +136,57 @@ int load_command_history(shell_info *info)
 
 
 /**
- * append_to_history - Adds an entry to the history linked list.
- * @info: Structure containing potential arguments, including the history list.
+ * append_to_history - Adds an entry to the history.
+ * @info: Structure containing potential arguments, including the history.
  * @buf: The command line buffer to add to the history.
- * @linecount: The history line count (histcount).
  *
- * Return: Always 0.
+ * Description: Once HISTORY_MAX entries are kept, each new one evicts
+ * the oldest, see historyAdd(). The line is also appended to the
+ * history file right away. HISTCONTROL may leave it out, see
+ * historyKeep(). The line takes the next history number, after those
+ * of the lines a shared history file brings in first, and is stamped
+ * with the time and the working directory. How long it runs and its
+ * status are filled in once it is done, see historyResult().
+ *
+ * Return: 1 if the line was added, 0 otherwise.
  */
-int append_to_history(shell_info *info, char *buf, int linecount)
+int append_to_history(shell_info *info, char *buf)
 {
-    if (!info->history)
+    int locked = lockJournal(info), kept = historyKeep(info, buf);
+    history_t *h = kept ? historyRing(info) : NULL;
+    hist_entry_t *e;
+
+    info->hist_last = h ? info->histcount : -1;
+    if (h)
     {
-        /* Initialize history list if it's empty */
-        info->history = NULL;
+        historyAdd(h, buf, info->histcount++);
+        e = historyAt(h, h->count - 1);
+        e->time = time(NULL);
+        e->cwd = internDir(info, getEnvironment(info, "PWD="));
     }
+    if (kept)
+        journalHistory(info, buf);
+    if (locked && info->hist_fd >= 0)
+        flock(info->hist_fd, LOCK_UN);
 
-    /* Add the new history entry to the end of the list */
-    append_node(&(info->history), buf, linecount);
-
-    return 0;
+    return kept;
 }
 
 /**
- * renumberHistory - Renumbers the history linked list after changes.
- * @info: Structure containing the history list.
+ * renumberHistory - Renumbers the history after changes.
+ * @info: Structure containing the history.
  *
  * Return: The updated count of history entries.
  */
 int renumberHistory(shell_info *info)
 {
-    list_t *current_node;
-    int index = 0;
+    hist_entry_t *e;
+    int index = 0, i;
 
-    for (current_node = info->history; current_node; current_node = current_node->next)
-    {
-        current_node->num = index++;
-    }
+    for (i = 0; (e = historyAt(info->history, i)); i++)
+        if (!e->dead)
+            e->num = index++;
 
     info->histcount = index;
     return index;
 }
-
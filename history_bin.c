@@ -0,0 +1,205 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+
+/**
+ * snapshotPath - Gets the path of the binary history snapshot.
+ * @info: The parameter struct.
+ *
+ * Return: The allocated path, HISTORY_FILE with HISTORY_BIN appended, or
+ *         NULL on failure.
+ */
+char *snapshotPath(shell_info *info)
+{
+    char *file = getHistoryFile(info), *path;
+
+    path = file ? malloc(_strlen(file) + _strlen(HISTORY_BIN) + 1) : NULL;
+    if (path)
+    {
+        _strcpy(path, file);
+        _strcat(path, HISTORY_BIN);
+    }
+    free(file);
+    return (path);
+}
+
+/**
+ * internDir - Gives the id of a directory history entries are read in.
+ * @info: The parameter struct holding the directories.
+ * @dir: The directory, or NULL.
+ *
+ * Description: Each directory is kept once, however many entries were
+ * read in it; the list stays as short as the directories worked in.
+ *
+ * Return: The id, or -1 if dir is NULL or on allocation failure.
+ */
+int internDir(shell_info *info, char *dir)
+{
+    list_t *node;
+    int id = 0;
+
+    if (!dir)
+        return (-1);
+    for (node = info->hist_dirs; node; node = node->next, id++)
+        if (_strcmp(node->str, dir) == 0)
+            return (node->num);
+    return (append_node(&info->hist_dirs, dir, id) ? id : -1);
+}
+
+/**
+ * loadSnapshot - Loads the history from its binary snapshot.
+ * @info: The parameter struct.
+ * @text: The status of the history file.
+ *
+ * Description: The snapshot is mapped read-only and its records added
+ * with no line to split or parse, each through historyKeep() so the
+ * HISTCONTROL of this shell applies as it does to the text file, whatever
+ * the one of the shell that took the snapshot. It is only used if it
+ * was taken of the history file as it is, give or take the lines
+ * appended to it since, which are read from the offset returned.
+ *
+ * Return: Offset in the history file of the lines the snapshot does not
+ *         hold, 0 if it is not used.
+ */
+long loadSnapshot(shell_info *info, struct stat *text)
+{
+    char *path = snapshotPath(info), *heap;
+    hist_header_t *head = MAP_FAILED;
+    hist_record_t *rec;
+    hist_entry_t *e;
+    struct stat st;
+    size_t size;
+    long i, off;
+    int fd = path ? open(path, O_RDONLY | O_CLOEXEC) : -1;
+
+    free(path);
+    if (fd != -1 && fstat(fd, &st) == 0 && st.st_size > (off_t)sizeof(*head))
+        head = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (fd != -1)
+        close(fd);
+    if (head == MAP_FAILED)
+        return (0);
+    rec = (hist_record_t *)(head + 1);
+    heap = (char *)(rec + head->count);
+    size = st.st_size - sizeof(*head);
+    if (memcmp(head->magic, HISTORY_MAGIC, 4) != 0 ||
+            head->version != HISTORY_VERSION || head->count < 0 ||
+            (size_t)head->count > size / sizeof(*rec) ||
+            head->heap != size - head->count * sizeof(*rec) ||
+            !head->heap || heap[head->heap - 1] != '\0' ||
+            head->text_ino != text->st_ino || head->text_off > text->st_size)
+        return (munmap(head, st.st_size), 0);
+
+    for (i = 0; i < head->count && historyRing(info); i++, rec++)
+    {
+        if (rec->off >= head->heap || !historyKeep(info, heap + rec->off))
+            continue;
+        historyAdd(info->history, heap + rec->off, 0);
+        e = historyAt(info->history, info->history->count - 1);
+        e->time = rec->time;
+        e->usec = rec->usec;
+        e->status = rec->status;
+        e->cwd = rec->cwd >= 0 && (size_t)rec->cwd < head->heap ?
+            internDir(info, heap + rec->cwd) : -1;
+    }
+    info->hist_lines = head->text_lines;
+    info->hist_seq = head->text_seq;
+    off = info->hist_snap = head->text_off;
+    munmap(head, st.st_size);
+    return (off);
+}
+
+/**
+ * snapshotHeap - Lays out the history for its binary snapshot.
+ * @info: The parameter struct holding the history.
+ * @rec: Filled in with a record for each live entry.
+ * @size: Set to the size of the heap.
+ *
+ * Description: The heap holds each directory once, then the text of
+ * each entry, NUL-terminated.
+ *
+ * Return: The allocated heap, or NULL on allocation failure.
+ */
+char *snapshotHeap(shell_info *info, hist_record_t *rec, size_t *size)
+{
+    int i, ndirs = listLen(info->hist_dirs);
+    size_t *dir = malloc(sizeof(size_t) * (ndirs + 1));
+    hist_entry_t *e;
+    list_t *node;
+    char *heap;
+
+    for (*size = 1, node = info->hist_dirs; node; node = node->next)
+        *size += _strlen(node->str) + 1;
+    for (i = 0; (e = historyAt(info->history, i)); i++)
+        *size += e->dead ? 0 : e->len + 1;
+    heap = dir ? malloc(*size) : NULL;
+    if (!heap)
+        return (free(dir), NULL);
+
+    for (*size = 1, *heap = '\0', i = 0, node = info->hist_dirs; node;
+            node = node->next, i++)
+    {
+        dir[i] = *size;
+        _strcpy(heap + *size, node->str);
+        *size += _strlen(node->str) + 1;
+    }
+    for (i = 0; (e = historyAt(info->history, i)); i++)
+    {
+        if (e->dead)
+            continue;
+        rec->time = e->time, rec->usec = e->usec, rec->status = e->status;
+        rec->cwd = e->cwd >= 0 && e->cwd < ndirs ? (int)dir[e->cwd] : -1;
+        rec->off = *size, rec->len = e->len;
+        memcpy(heap + *size, info->history->arena + e->off, e->len + 1);
+        *size += e->len + 1, rec++;
+    }
+    free(dir);
+    return (heap);
+}
+
+/**
+ * writeSnapshot - Saves the binary snapshot of the history.
+ * @info: The parameter struct holding the history.
+ * @text: The status of the history file, whose lines the history holds.
+ *
+ * Description: The file is written under a temporary name and renamed
+ * over the old one, like a compiled script.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int writeSnapshot(shell_info *info, struct stat *text)
+{
+    char *path = snapshotPath(info), *tmp = NULL, *heap = NULL;
+    history_t *h = info->history;
+    hist_header_t head;
+    hist_record_t *rec;
+    struct iovec iov[3];
+    int fd, ok = 0;
+
+    _memset((char *)&head, 0, sizeof(head));
+    head.count = h ? h->count - h->dead : 0;
+    rec = malloc(sizeof(*rec) * (head.count + 1));
+    heap = rec && path ? snapshotHeap(info, rec, &head.heap) : NULL;
+    tmp = heap ? malloc(_strlen(path) + 24) : NULL;
+    if (tmp)
+    {
+        memcpy(head.magic, HISTORY_MAGIC, 4);
+        head.version = HISTORY_VERSION;
+        head.text_ino = text->st_ino, head.text_off = text->st_size;
+        head.text_lines = info->hist_lines, head.text_seq = info->hist_seq;
+        iov[0].iov_base = &head, iov[0].iov_len = sizeof(head);
+        iov[1].iov_base = rec, iov[1].iov_len = sizeof(*rec) * head.count;
+        iov[2].iov_base = heap, iov[2].iov_len = head.heap;
+        _strcpy(tmp, path);
+        _strcat(tmp, ".");
+        _strcat(tmp, convert_number(getpid(), 10, 0));
+        fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        ok = fd != -1 && writev(fd, iov, 3) == (ssize_t)(iov[0].iov_len +
+                    iov[1].iov_len + iov[2].iov_len);
+        if (fd != -1 && (close(fd) == -1 || !ok || rename(tmp, path) == -1))
+            unlink(tmp), ok = 0;
+    }
+    free(path), free(tmp), free(heap), free(rec);
+    return (ok ? 0 : -1);
+}
@@ -0,0 +1,146 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * dedupFind - Finds a live history entry by its text.
+ * @h: The history.
+ * @line: The text.
+ * @len: Its length.
+ * @hash: Its hash.
+ *
+ * Return: Slot of the entry, or -1 if there is none.
+ */
+int dedupFind(history_t *h, char *line, size_t len, unsigned long hash)
+{
+    int slot = h->buckets[hash % HISTORY_MAX] - 1;
+    hist_entry_t *e;
+
+    while (slot >= 0)
+    {
+        e = h->entries + slot;
+        if (e->hash == hash && e->len == len &&
+                memcmp(h->arena + e->off, line, len) == 0)
+            return (slot);
+        slot = e->next - 1;
+    }
+    return (-1);
+}
+
+/**
+ * dedupLink - Adds an entry to its dedup bucket, or removes it.
+ * @h: The history.
+ * @slot: Slot of the entry.
+ * @add: Nonzero to add the entry, zero to remove it.
+ *
+ * Return: void
+ */
+void dedupLink(history_t *h, int slot, int add)
+{
+    hist_entry_t *e = h->entries + slot;
+    int *link = h->buckets + e->hash % HISTORY_MAX;
+
+    if (add)
+    {
+        e->next = *link;
+        *link = slot + 1;
+        return;
+    }
+    while (*link && *link != slot + 1)
+        link = &h->entries[*link - 1].next;
+    if (*link)
+        *link = e->next;
+}
+
+/**
+ * historyErase - Erases a history entry that a newer one duplicates.
+ * @info: The parameter struct holding the history.
+ * @slot: Slot of the entry.
+ *
+ * Description: The entry is only marked dead: its slot and text are
+ * reclaimed when it is evicted, or when dead entries make up an eighth
+ * of the ring and it is compacted.
+ *
+ * Return: void
+ */
+void historyErase(shell_info *info, int slot)
+{
+    history_t *h = info->history;
+
+    dedupLink(h, slot, 0);
+    h->entries[slot].dead = 1;
+    if (++h->dead * 8 > h->count)
+        compactRing(info);
+}
+
+/**
+ * compactRing - Rebuilds the history without its dead entries.
+ * @info: The parameter struct holding the history.
+ *
+ * Description: The text of each live entry is packed into the new arena
+ * and the entry itself is carried over whole: its time, duration,
+ * status and directory are kept, only its offset and dedup link change.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int compactRing(shell_info *info)
+{
+    history_t *old = info->history, *h = calloc(1, sizeof(history_t));
+    hist_entry_t *e, *moved;
+    size_t off;
+    int i, next;
+
+    if (!h)
+        return (-1);
+    for (i = 0; (e = historyAt(old, i)); i++)
+    {
+        if (e->dead)
+            continue;
+        historyAdd(h, old->arena + e->off, e->num);
+        moved = historyAt(h, h->count - 1);
+        off = moved->off;
+        next = moved->next;
+        *moved = *e;
+        moved->off = off;
+        moved->next = next;
+    }
+    info->history = h;
+    freeHistory(&old);
+    return (0);
+}
+
+/**
+ * historyKeep - Applies HISTCONTROL to a line about to enter the history.
+ * @info: The parameter struct holding the history.
+ * @line: The line.
+ *
+ * Description: With ignorespace a line starting with a space is left
+ * out, and with ignoredups one repeating the newest entry. With
+ * erasedups the older entries it repeats are erased, found through the
+ * dedup buckets.
+ *
+ * Return: 1 if the line is to be added, 0 otherwise.
+ */
+int historyKeep(shell_info *info, char *line)
+{
+    int policy = histControl(info), slot;
+    size_t len = _strlen(line);
+    hist_entry_t *last;
+    unsigned long hash;
+
+    if ((policy & HC_IGNORESPACE) && *line == ' ')
+        return (0);
+    if (!info->history || !(policy & (HC_IGNOREDUPS | HC_ERASEDUPS)))
+        return (1);
+    len = len < HISTORY_ARENA ? len : HISTORY_ARENA - 1;
+    hash = hashBytes(HASH_SEED, line, len);
+    last = historyAt(info->history, info->history->count - 1);
+    if ((policy & HC_IGNOREDUPS) && last && !last->dead &&
+            last->hash == hash && last->len == len &&
+            memcmp(info->history->arena + last->off, line, len) == 0)
+        return (0);
+
+    while ((policy & HC_ERASEDUPS) &&
+            (slot = dedupFind(info->history, line, len, hash)) >= 0)
+        historyErase(info, slot);
+    return (1);
+}
@@ -0,0 +1,152 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * gramSlot - Finds the list of a trigram in the index.
+ * @idx: The index.
+ * @gram: The trigram plus one.
+ * @add: If nonzero, a missing trigram is added with an empty list.
+ *
+ * Return: The list, or NULL if the trigram is missing and not added.
+ */
+gram_list_t *gramSlot(hist_index_t *idx, unsigned long gram, int add)
+{
+    size_t i;
+
+    if (add && (idx->used + 1) * 2 > idx->size && growIndex(idx) == -1)
+        return (NULL);
+    if (!idx->size)
+        return (NULL);
+    i = (gram * 2654435761UL) & (idx->size - 1);
+    while (idx->slots[i].gram && idx->slots[i].gram != gram)
+        i = (i + 1) & (idx->size - 1);
+    if (!idx->slots[i].gram && !add)
+        return (NULL);
+    if (!idx->slots[i].gram)
+        idx->slots[i].gram = gram, idx->used++;
+    return (idx->slots + i);
+}
+
+/**
+ * growIndex - Doubles the table of the index, keeping it half empty.
+ * @idx: The index.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int growIndex(hist_index_t *idx)
+{
+    hist_index_t grown;
+    gram_list_t *slot;
+    size_t i;
+
+    grown.size = idx->size ? idx->size * 2 : 1024;
+    grown.used = 0;
+    grown.slots = malloc(sizeof(gram_list_t) * grown.size);
+    if (!grown.slots)
+        return (-1);
+    _memset((char *)grown.slots, 0, sizeof(gram_list_t) * grown.size);
+    for (i = 0; i < idx->size; i++)
+    {
+        if (!idx->slots[i].gram)
+            continue;
+        slot = gramSlot(&grown, idx->slots[i].gram, 1);
+        *slot = idx->slots[i];
+    }
+    free(idx->slots);
+    *idx = grown;
+    return (0);
+}
+
+/**
+ * indexAdd - Adds an entry, the newest, to the trigram index.
+ * @h: The history.
+ * @e: The entry.
+ * @seq: Its sequence number.
+ *
+ * Description: Entries come in order, so each list stays sorted by just
+ * appending, and a trigram that occurs twice in the line is found at the
+ * end of its list already. When the index cannot grow, the entry is
+ * left out of the lists the memory is missing for. Nothing is done until
+ * the index is built, see historySearch().
+ *
+ * Return: void
+ */
+void indexAdd(history_t *h, hist_entry_t *e, unsigned long seq)
+{
+    unsigned char *s = (unsigned char *)h->arena + e->off;
+    gram_list_t *l;
+    unsigned long *grown;
+    size_t i, cap;
+
+    if (!h->indexed)
+        return;
+    for (i = 0; i + 3 <= e->len; i++)
+    {
+        l = gramSlot(&h->index, TRIGRAM(s + i), 1);
+        if (!l || (l->len > l->head && l->seq[l->len - 1] == seq))
+            continue;
+        if (l->len == l->cap && l->head)
+        {
+            memmove(l->seq, l->seq + l->head, sizeof(*l->seq) *
+                    (l->len - l->head));
+            l->len -= l->head, l->head = 0;
+        }
+        if (l->len == l->cap)
+        {
+            cap = l->cap ? l->cap * 2 : 4;
+            grown = realloc(l->seq, sizeof(*l->seq) * cap);
+            if (!grown)
+                continue;
+            l->seq = grown;
+            l->cap = cap;
+        }
+        l->seq[l->len++] = seq;
+    }
+}
+
+/**
+ * indexRemove - Removes an entry, the oldest, from the trigram index.
+ * @h: The history.
+ * @e: The entry, its text still in the arena.
+ * @seq: Its sequence number.
+ *
+ * Description: Being the oldest, the entry is at the head of the list of
+ * each of its trigrams, so removing it takes no search.
+ *
+ * Return: void
+ */
+void indexRemove(history_t *h, hist_entry_t *e, unsigned long seq)
+{
+    unsigned char *s = (unsigned char *)h->arena + e->off;
+    gram_list_t *l;
+    size_t i;
+
+    if (!h->indexed)
+        return;
+    for (i = 0; i + 3 <= e->len; i++)
+    {
+        l = gramSlot(&h->index, TRIGRAM(s + i), 0);
+        if (l && l->head < l->len && l->seq[l->head] == seq)
+            l->head++;
+        if (l && l->head == l->len)
+            l->head = l->len = 0;
+    }
+}
+
+/**
+ * freeHistory - Frees a history and its index.
+ * @h: Address of the history, set to NULL.
+ *
+ * Return: void
+ */
+void freeHistory(history_t **h)
+{
+    size_t i;
+
+    if (!*h)
+        return;
+    for (i = 0; i < (*h)->index.size; i++)
+        free((*h)->index.slots[i].seq);
+    free((*h)->index.slots);
+    bfree((void **)h);
+}
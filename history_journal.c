@@ -0,0 +1,148 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <sys/uio.h>
+
+/**
+ * openJournal - Opens the history file for appending, once.
+ * @info: The parameter struct; the file stays open in info->hist_fd.
+ *
+ * Description: If the file is not the one whose lines were read up to
+ * info->hist_off, another shell replaced it while compacting; reading
+ * resumes where it left off in the new one, see seekJournal().
+ *
+ * Return: The descriptor, or -1 if the file cannot be opened.
+ */
+int openJournal(shell_info *info)
+{
+    struct stat st;
+    char *file;
+
+    if (info->hist_fd != -1)
+        return (info->hist_fd < 0 ? -1 : info->hist_fd);
+    file = getHistoryFile(info);
+    info->hist_fd = file ? open(file, O_RDWR | O_APPEND | O_CREAT |
+            O_CLOEXEC, 0644) : -1;
+    free(file);
+    if (info->hist_fd < 0)
+        return (info->hist_fd = -2, -1);
+    if (fstat(info->hist_fd, &st) == 0 && st.st_ino != info->hist_ino)
+    {
+        if (info->hist_ino)
+            seekJournal(info);
+        info->hist_ino = st.st_ino;
+    }
+    return (info->hist_fd);
+}
+
+/**
+ * journalHistory - Appends a command line to the history file.
+ * @info: The parameter struct; the file stays open in info->hist_fd.
+ * @line: The line.
+ *
+ * Description: Each line is written as soon as it is read, with a
+ * single writev() on an O_APPEND descriptor, so a crash loses nothing
+ * and shells sharing the file never interleave parts of lines. Once the
+ * file holds twice HISTORY_MAX lines it is compacted. The server mode
+ * keeps its clients' lines out of the file.
+ *
+ * Return: void
+ */
+void journalHistory(shell_info *info, char *line)
+{
+    struct iovec iov[2];
+    ssize_t wrote;
+
+    if (info->serve_fd >= 0 || openJournal(info) == -1)
+        return;
+
+    iov[0].iov_base = line;
+    iov[0].iov_len = _strlen(line);
+    iov[1].iov_base = "\n";
+    iov[1].iov_len = 1;
+    wrote = writev(info->hist_fd, iov, 2);
+    if (wrote > 0)
+        info->hist_lines++, info->hist_off += wrote, info->hist_seq++;
+    if (info->hist_lines >= 2 * HISTORY_MAX)
+        compactHistory(info);
+}
+
+/**
+ * historyText - Joins the live lines of the history, one per line.
+ * @info: The parameter struct holding the history.
+ * @size: Set to the size of the text.
+ *
+ * Return: The allocated text, or NULL on failure.
+ */
+char *historyText(shell_info *info, size_t *size)
+{
+    hist_entry_t *e;
+    char *text;
+    int i;
+
+    *size = 0;
+    for (i = 0; (e = historyAt(info->history, i)); i++)
+        *size += e->dead ? 0 : e->len + 1;
+    text = malloc(*size + 1);
+    if (!text)
+        return (NULL);
+
+    *size = 0;
+    for (i = 0; (e = historyAt(info->history, i)); i++)
+    {
+        if (e->dead)
+            continue;
+        memcpy(text + *size, info->history->arena + e->off, e->len);
+        *size += e->len;
+        text[(*size)++] = '\n';
+    }
+    return (text);
+}
+
+/**
+ * compactHistory - Rewrites the history file with the newest lines only.
+ * @info: The parameter struct.
+ *
+ * Description: The lines in memory, at most HISTORY_MAX, are written to
+ * a temporary file that is renamed over the history file, so the file
+ * is whole at every moment. A shared file keeps its own newest lines
+ * instead, see sharedText(). The journal is reopened on the new file at
+ * the next line; closing the old one drops the lock of a shared history.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int compactHistory(shell_info *info)
+{
+    char *file = getHistoryFile(info), *tmp, *text;
+    struct stat st;
+    size_t size;
+    int fd, ok = 0;
+
+    text = !file ? NULL : info->hist_share ? sharedText(info, &size) :
+        historyText(info, &size);
+    tmp = text ? malloc(_strlen(file) + 24) : NULL;
+    if (tmp)
+    {
+        _strcpy(tmp, file);
+        _strcat(tmp, ".");
+        _strcat(tmp, convert_number(getpid(), 10, 0));
+        fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        ok = fd != -1 && write(fd, text, size) == (ssize_t)size &&
+            fstat(fd, &st) == 0;
+        if (fd != -1 && (close(fd) == -1 || !ok || rename(tmp, file) == -1))
+            unlink(tmp), ok = 0;
+    }
+    if (ok && info->hist_fd >= 0)
+        close(info->hist_fd);
+    if (ok)
+    {
+        info->hist_fd = -1;
+        info->hist_ino = st.st_ino;
+        info->hist_off = size;
+        for (info->hist_lines = 0; size--;)
+            info->hist_lines += text[size] == '\n';
+    }
+    free(text);
+    free(tmp);
+    free(file);
+    return (ok ? 0 : -1);
+}
@@ -0,0 +1,131 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * historyRing - Gives the history ring, creating it on first use.
+ * @info: The parameter struct.
+ *
+ * Description: The ring is a single allocation: HISTORY_MAX entries and
+ * an arena of HISTORY_ARENA bytes for their text, so the history never
+ * takes more memory however long the session. It comes from calloc(),
+ * whose fresh pages are zero already, so the parts not used yet cost
+ * nothing.
+ *
+ * Return: The ring, or NULL on allocation failure.
+ */
+history_t *historyRing(shell_info *info)
+{
+    if (!info->history)
+        info->history = calloc(1, sizeof(history_t));
+    return (info->history);
+}
+
+/**
+ * historyEvict - Drops the oldest history entry.
+ * @h: The ring.
+ *
+ * Return: void
+ */
+void historyEvict(history_t *h)
+{
+    hist_entry_t *e = h->entries + h->first;
+
+    if (!h->count)
+        return;
+    if (e->dead)
+        h->dead--;
+    else
+        dedupLink(h, h->first, 0);
+    indexRemove(h, e, h->base++);
+    h->first = (h->first + 1) % HISTORY_MAX;
+    if (!--h->count)
+        h->tail = 0;
+}
+
+/**
+ * historyAdd - Appends a line to the history ring.
+ * @h: The ring.
+ * @line: The line.
+ * @num: Its history number.
+ *
+ * Description: The text goes right after the newest entry's, or at the
+ * start of the arena when it does not fit before the end. Entries whose
+ * text is in the way are the oldest ones and are evicted, as is the
+ * oldest entry when all HISTORY_MAX slots are taken. A line longer than
+ * the arena is cut. The entry is added to the trigram index and to its
+ * dedup bucket.
+ *
+ * Return: void
+ */
+void historyAdd(history_t *h, char *line, int num)
+{
+    size_t len = _strlen(line), start, off;
+    hist_entry_t *e;
+
+    if (len >= HISTORY_ARENA)
+        len = HISTORY_ARENA - 1;
+    if (h->count == HISTORY_MAX)
+        historyEvict(h);
+    start = h->tail + len + 1 <= HISTORY_ARENA ? h->tail : 0;
+    while (h->count)
+    {
+        off = h->entries[h->first].off;
+        if (start == h->tail ? off < h->tail || off >= start + len + 1 :
+                off < h->tail && off >= len + 1)
+            break;
+        historyEvict(h);
+    }
+
+    e = h->entries + (h->first + h->count++) % HISTORY_MAX;
+    e->off = start;
+    e->len = len;
+    e->num = num;
+    e->hash = hashBytes(HASH_SEED, line, len);
+    e->dead = 0;
+    e->time = 0;
+    e->usec = -1;
+    e->status = -1;
+    e->cwd = -1;
+    dedupLink(h, e - h->entries, 1);
+    memcpy(h->arena + start, line, len);
+    h->arena[start + len] = '\0';
+    h->tail = start + len + 1;
+    indexAdd(h, e, h->base + h->count - 1);
+}
+
+/**
+ * historyAt - Gives an entry of the history.
+ * @h: The ring, or NULL.
+ * @i: Position of the entry, 0 being the oldest.
+ *
+ * Return: The entry, or NULL if there is none at i.
+ */
+hist_entry_t *historyAt(history_t *h, int i)
+{
+    if (!h || i < 0 || i >= h->count)
+        return (NULL);
+    return (h->entries + (h->first + i) % HISTORY_MAX);
+}
+
+/**
+ * printHistory - Prints the history, each line after its number.
+ * @info: The parameter struct.
+ *
+ * Return: The number of entries printed.
+ */
+int printHistory(shell_info *info)
+{
+    hist_entry_t *e;
+    int i;
+
+    for (i = 0; (e = historyAt(info->history, i)); i++)
+    {
+        if (e->dead)
+            continue;
+        _puts(convert_number(e->num, 10, 0));
+        _puts(": ");
+        _puts(info->history->arena + e->off);
+        _putchar('\n');
+    }
+    return (i);
+}
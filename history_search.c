@@ -0,0 +1,202 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <termios.h>
+
+/**
+ * indexHistory - Builds the trigram index of the history, once.
+ * @h: The history.
+ *
+ * Description: Loading the history does not pay for the index: it is
+ * built for the first search and kept up to date from then on.
+ *
+ * Return: void
+ */
+void indexHistory(history_t *h)
+{
+    int i;
+
+    if (h->indexed)
+        return;
+    h->indexed = 1;
+    for (i = 0; i < h->count; i++)
+        indexAdd(h, historyAt(h, i), h->base + i);
+}
+
+/**
+ * historySearch - Finds the newest history entry holding a pattern.
+ * @h: The history, or NULL.
+ * @pattern: The pattern, a plain string.
+ * @from: Only entries older than the one at this position are searched.
+ *
+ * Description: Only the entries listed under the rarest trigram of the
+ * pattern are compared with it, found from the newest by a binary
+ * search; if one of its trigrams occurs nowhere, nothing is. A pattern
+ * shorter than a trigram is compared with every entry. Entries erased
+ * as duplicates are passed over.
+ *
+ * Return: Position of the entry, or -1 if there is none.
+ */
+int historySearch(history_t *h, char *pattern, int from)
+{
+    unsigned char *p = (unsigned char *)pattern;
+    gram_list_t *l, *best = NULL;
+    size_t i, lo, hi, mid;
+    int pos;
+
+    if (!h)
+        return (-1);
+    indexHistory(h);
+    from = from > h->count ? h->count : from;
+    for (i = 0; p[i] && p[i + 1] && p[i + 2]; i++)
+    {
+        l = gramSlot(&h->index, TRIGRAM(p + i), 0);
+        if (!l || l->head == l->len)
+            return (-1);
+        if (!best || l->len - l->head < best->len - best->head)
+            best = l;
+    }
+    if (!best)
+    {
+        for (pos = from - 1; pos >= 0; pos--)
+            if (!historyAt(h, pos)->dead &&
+                    strstr(h->arena + historyAt(h, pos)->off, pattern))
+                return (pos);
+        return (-1);
+    }
+
+    for (lo = best->head, hi = best->len; lo < hi;)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (best->seq[mid] < h->base + from)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    for (; lo > best->head; lo--)
+    {
+        pos = best->seq[lo - 1] - h->base;
+        if (!historyAt(h, pos)->dead &&
+                strstr(h->arena + historyAt(h, pos)->off, pattern))
+            return (pos);
+    }
+    return (-1);
+}
+
+/**
+ * searchKey - Makes SEARCH_KEY end a line typed at the prompt, or stops.
+ * @info: The parameter struct.
+ * @on: Nonzero before reading the line, zero after it.
+ *
+ * Description: The terminal stays in canonical mode, with its own line
+ * editing; SEARCH_KEY is made an extra end of line (VEOL) instead of
+ * redrawing the line, so the shell sees it as soon as it is typed. The
+ * settings are put back before a command runs.
+ *
+ * Return: void
+ */
+void searchKey(shell_info *info, int on)
+{
+    static struct termios saved;
+    struct termios t;
+
+    if (on && !info->search.key && interactive(info) &&
+            tcgetattr(info->readfd, &saved) == 0)
+    {
+        t = saved;
+        t.c_cc[VEOL] = SEARCH_KEY;
+        t.c_cc[VREPRINT] = _POSIX_VDISABLE;
+        info->search.key = tcsetattr(info->readfd, TCSANOW, &t) == 0;
+    }
+    else if (!on && info->search.key)
+    {
+        tcsetattr(info->readfd, TCSANOW, &saved);
+        info->search.key = 0;
+    }
+}
+
+/**
+ * searchStep - Adds to the pattern of the reverse search and shows the
+ *              entry found.
+ * @info: The parameter struct.
+ * @text: What was typed before SEARCH_KEY; if empty, the next older
+ *        entry holding the pattern is searched for.
+ *
+ * Return: Position of the entry found, or -1 if there is none.
+ */
+int searchStep(shell_info *info, char *text)
+{
+    search_t *s = &info->search;
+    int count = info->history ? info->history->count : 0, pos;
+    char *pattern;
+
+    pattern = malloc(_strlen(s->pattern ? s->pattern : "") +
+            _strlen(text) + 1);
+    if (!pattern)
+        return (-1);
+    _strcpy(pattern, s->pattern ? s->pattern : "");
+    _strcat(pattern, text);
+    if (!s->pattern)
+        s->pos = count;
+    free(s->pattern);
+    s->pattern = pattern;
+
+    pos = historySearch(info->history, pattern, *text ? s->pos + 1 : s->pos);
+    if (pos >= 0)
+        s->pos = pos;
+    _puts(pos >= 0 ? "\n(reverse-i-search)`" :
+            "\n(failed reverse-i-search)`");
+    _puts(pattern);
+    _puts("': ");
+    if (s->pos < count)
+        _puts(info->history->arena + historyAt(info->history, s->pos)->off);
+    _putchar('\n');
+    _putchar(BUF_FLUSH);
+    return (pos);
+}
+
+/**
+ * searchHistory - Runs a reverse search started by SEARCH_KEY.
+ * @info: The parameter struct.
+ * @buf: Address of the line read, ending with SEARCH_KEY; replaced by
+ *       the line to run.
+ * @length: Address of the allocated size of *buf.
+ * @got: Length of the line.
+ *
+ * Description: Each line ending with SEARCH_KEY adds what was typed to
+ * the pattern, or looks further back if nothing was. An empty line then
+ * runs the entry found; any other line ends the search and runs as
+ * typed.
+ *
+ * Return: Length of the line to run, or -1 on EOF.
+ */
+ssize_t searchHistory(shell_info *info, char **buf, size_t *length,
+        ssize_t got)
+{
+    hist_entry_t *e;
+    char *grown;
+
+    while (got > 0 && (*buf)[got - 1] == SEARCH_KEY)
+    {
+        (*buf)[got - 1] = '\0';
+        searchStep(info, *buf);
+        got = custom_getline(info, buf, length);
+    }
+    e = historyAt(info->history, info->search.pos);
+    bfree((void **)&info->search.pattern);
+    if (got != 1 || **buf != '\n' || !e)
+        return (got);
+
+    if (*length < e->len + 1)
+    {
+        grown = realloc(*buf, e->len + 1);
+        if (!grown)
+            return (-1);
+        *buf = grown;
+        *length = e->len + 1;
+    }
+    memcpy(*buf, info->history->arena + e->off, e->len + 1);
+    _puts(*buf);
+    _putchar('\n');
+    _putchar(BUF_FLUSH);
+    return (e->len);
+}
@@ -0,0 +1,190 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <sys/file.h>
+
+/**
+ * historyHeader - Reads the header of a compacted shared history file.
+ * @buf: The file, NUL-terminated.
+ * @rest: Set to the first line after the header, or to buf without one.
+ *
+ * Description: The header is a line "#N", N being the sequence number
+ * of the line after it; bash uses the same form for its timestamps.
+ *
+ * Return: N, or 0 if there is no header.
+ */
+unsigned long historyHeader(char *buf, char **rest)
+{
+    unsigned long seq = 0;
+    char *p = buf + 1;
+
+    *rest = buf;
+    if (*buf != '#' || *p < '0' || *p > '9')
+        return (0);
+    while (*p >= '0' && *p <= '9')
+        seq = seq * 10 + (*p++ - '0');
+    if (*p != '\n')
+        return (0);
+    *rest = p + 1;
+    return (seq);
+}
+
+/**
+ * seekJournal - Finds where to resume reading a replaced history file.
+ * @info: The parameter struct; info->hist_fd is the new file.
+ *
+ * Description: A compacted shared file gives the sequence number of its
+ * first line, so the line numbered info->hist_seq is found by counting
+ * lines from there. Lines older than the first were dropped and are
+ * passed over. A file without a header is resumed at its end.
+ *
+ * Return: 0 on success, -1 if reading resumes at the end.
+ */
+int seekJournal(shell_info *info)
+{
+    struct stat st;
+    char *buf = NULL, *p, *nl, *end;
+    unsigned long seq;
+
+    if (fstat(info->hist_fd, &st) == 0)
+        buf = malloc(st.st_size + 1);
+    info->hist_off = buf ? st.st_size : info->hist_off;
+    if (!buf || pread(info->hist_fd, buf, st.st_size, 0) != st.st_size)
+        return (free(buf), -1);
+    end = buf + st.st_size;
+    *end = '\0';
+    seq = historyHeader(buf, &p);
+    if (p == buf)
+        return (free(buf), -1);
+
+    for (; seq < info->hist_seq && (nl = memchr(p, '\n', end - p)); seq++)
+        p = nl + 1;
+    info->hist_seq = seq;
+    info->hist_off = p - buf;
+    info->hist_lines = 0;
+    for (p = buf; (nl = memchr(p, '\n', end - p)); p = nl + 1)
+        info->hist_lines++;
+    free(buf);
+    return (0);
+}
+
+/**
+ * lockJournal - Locks the shared history file and catches up with it.
+ * @info: The parameter struct.
+ *
+ * Description: With SHARE_HISTORY_VAR set, shells append to the history
+ * file one at a time under flock(). A shell that waited for the lock
+ * while another renamed a compacted file over the old one holds the
+ * lock of a file no longer in use, so it reopens the new one and locks
+ * it instead. The lines the others appended since are then read in,
+ * see syncHistory().
+ *
+ * Return: 1 if the file is locked, 0 if the history is not shared or the
+ *         file cannot be locked.
+ */
+int lockJournal(shell_info *info)
+{
+    struct stat st;
+    char *file;
+
+    if (!info->hist_share || info->serve_fd >= 0 || openJournal(info) == -1)
+        return (0);
+    while (flock(info->hist_fd, LOCK_EX) == 0)
+    {
+        file = getHistoryFile(info);
+        if (!file || stat(file, &st) == -1 || st.st_ino == info->hist_ino)
+        {
+            free(file);
+            syncHistory(info);
+            return (1);
+        }
+        free(file);
+        close(info->hist_fd);
+        info->hist_fd = -1;
+        if (openJournal(info) == -1)
+            return (0);
+    }
+    return (0);
+}
+
+/**
+ * syncHistory - Reads in the lines other shells added to the history file.
+ * @info: The parameter struct; info->hist_off is where reading resumes.
+ *
+ * Description: Only the part of the file past info->hist_off is read, in
+ * one pread(), and only whole lines are taken from it. The lines go
+ * through HISTCONTROL and get the next history numbers, as if typed.
+ *
+ * Return: void
+ */
+void syncHistory(shell_info *info)
+{
+    struct stat st;
+    history_t *h;
+    char *buf, *line, *nl;
+    size_t len;
+
+    if (fstat(info->hist_fd, &st) == -1 || st.st_size <= info->hist_off)
+        return;
+    len = st.st_size - info->hist_off;
+    buf = malloc(len + 1);
+    if (!buf || pread(info->hist_fd, buf, len, info->hist_off) !=
+            (ssize_t)len)
+    {
+        free(buf);
+        return;
+    }
+
+    for (line = buf; (nl = memchr(line, '\n', buf + len - line));
+            line = nl + 1)
+    {
+        *nl = '\0';
+        if (historyKeep(info, line) && (h = historyRing(info)))
+            historyAdd(h, line, info->histcount++);
+        info->hist_lines++;
+        info->hist_seq++;
+    }
+    info->hist_off += line - buf;
+    free(buf);
+}
+
+/**
+ * sharedText - Gives the newest lines of the shared history file, for
+ *              compacting it.
+ * @info: The parameter struct; the file is locked.
+ * @size: Set to the size of the text.
+ *
+ * Description: The file, not the history in memory, is what the shells
+ * share, so its own newest HISTORY_MAX lines are kept, whatever
+ * HISTCONTROL left out of memory. The header gives the sequence number
+ * of the first, so the other shells can find their place in it.
+ *
+ * Return: The allocated text, or NULL on failure.
+ */
+char *sharedText(shell_info *info, size_t *size)
+{
+    struct stat st;
+    char *buf = NULL, *text = NULL, *p, *nl, *end;
+    unsigned long seq, lines = 0;
+
+    if (fstat(info->hist_fd, &st) == 0)
+        buf = malloc(st.st_size + 1);
+    if (buf && pread(info->hist_fd, buf, st.st_size, 0) == st.st_size)
+        text = malloc(st.st_size + 24);
+    if (!text)
+        return (free(buf), NULL);
+    end = buf + st.st_size;
+    *end = '\0';
+    seq = historyHeader(buf, &p);
+    for (nl = p; (nl = memchr(nl, '\n', end - nl)); nl++)
+        lines++;
+    for (; lines > HISTORY_MAX && (nl = memchr(p, '\n', end - p)); lines--)
+        p = nl + 1, seq++;
+
+    _strcpy(text, "#");
+    _strcat(text, convert_number(seq, 10, CONVERT_UNSIGNED));
+    _strcat(text, "\n");
+    *size = _strlen(text) + (end - p);
+    memcpy(text + _strlen(text), p, end - p);
+    free(buf);
+    return (text);
+}
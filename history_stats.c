@@ -0,0 +1,128 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * historyResult - Records how the line being run went on its history
+ *                 entry.
+ * @info: The parameter struct; info->status is the line's status.
+ * @usec: How long the line ran, in microseconds, or -1 if unknown.
+ *
+ * Description: The entry is looked for from the newest one back, past
+ * any line the command itself added. It may be gone: evicted, or erased
+ * as a duplicate of a line added since.
+ *
+ * Return: void
+ */
+void historyResult(shell_info *info, long usec)
+{
+    history_t *h = info->history;
+    hist_entry_t *e;
+    int i;
+
+    if (!h || info->hist_last < 0)
+        return;
+    for (i = h->count - 1; (e = historyAt(h, i)) &&
+            e->num > info->hist_last; i--)
+        ;
+    if (e && e->num == info->hist_last && !e->dead)
+    {
+        e->usec = usec;
+        e->status = info->status;
+    }
+    info->hist_last = -1;
+}
+
+/**
+ * byRun - Orders runs by command name, then the slowest first.
+ * @a: A run.
+ * @b: Another run.
+ *
+ * Return: Negative, zero or positive as a goes before, with or after b.
+ */
+int byRun(const void *a, const void *b)
+{
+    const hist_run_t *x = a, *y = b;
+    size_t len = x->len < y->len ? x->len : y->len;
+    int cmp = len ? memcmp(x->name, y->name, len) : 0;
+
+    if (cmp)
+        return (cmp);
+    if (x->len != y->len)
+        return (x->len < y->len ? -1 : 1);
+    if (x->usec != y->usec)
+        return (x->usec > y->usec ? -1 : 1);
+    return (x->e->num < y->e->num ? -1 : x->e->num > y->e->num);
+}
+
+/**
+ * historyRuns - Gives the history entries whose duration is known,
+ *               sorted by byRun().
+ * @info: The parameter struct holding the history.
+ * @names: If set, runs are grouped by command name; otherwise they are
+ *         sorted by duration alone.
+ * @n: Set to the number of runs.
+ *
+ * Return: The allocated runs, or NULL if there are none or on failure.
+ */
+hist_run_t *historyRuns(shell_info *info, int names, int *n)
+{
+    history_t *h = info->history;
+    hist_run_t *runs;
+    hist_entry_t *e;
+    char *text;
+    int i;
+
+    *n = 0;
+    runs = h ? malloc(sizeof(*runs) * (h->count + 1)) : NULL;
+    for (i = 0; runs && (e = historyAt(h, i)); i++)
+    {
+        if (e->dead || e->usec < 0)
+            continue;
+        text = h->arena + e->off;
+        text += strspn(text, " \t");
+        runs[*n].name = text;
+        runs[*n].len = names ? strcspn(text, " \t;&|<>()") : 0;
+        runs[*n].usec = e->usec;
+        runs[(*n)++].e = e;
+    }
+    if (!*n)
+        return (free(runs), NULL);
+    qsort(runs, *n, sizeof(*runs), byRun);
+    return (runs);
+}
+
+/**
+ * putDuration - Prints a duration in seconds, to the millisecond.
+ * @usec: The duration in microseconds, or -1 if unknown.
+ *
+ * Return: void
+ */
+void putDuration(long usec)
+{
+    if (usec < 0)
+    {
+        _puts("-");
+        return;
+    }
+    _puts(convert_fixed(usec, 1000000));
+    _putchar('s');
+}
+
+/**
+ * printRun - Prints a history entry with its duration and status.
+ * @h: The ring.
+ * @e: The entry.
+ *
+ * Return: void
+ */
+void printRun(history_t *h, hist_entry_t *e)
+{
+    _puts(convert_number(e->num, 10, 0));
+    _puts(": ");
+    putDuration(e->usec);
+    _putchar('\t');
+    _puts(e->status < 0 ? "-" : convert_number(e->status, 10, 0));
+    _putchar('\t');
+    _puts(h->arena + e->off);
+    _putchar('\n');
+}
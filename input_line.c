@@ -0,0 +1,106 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * parseLine - Lexes and parses a command line into info->ast.
+ * @info: The parameter struct; info->root is set to the root node, or
+ *        to -1 when the line cannot run.
+ * @line: The line, possibly several lines joined by continueLine().
+ *
+ * Description: The bodies of the line's here-documents are read as soon
+ * as it is lexed. Syntax errors are reported here.
+ *
+ * Return: PARSE_OK, PARSE_SYNTAX, or PARSE_INCOMPLETE if the line ends
+ *         inside a quote, a group or after an operator.
+ */
+int parseLine(shell_info *info, char *line)
+{
+    int n = lexLine(info, line);
+
+    info->root = -1;
+    if (n == -1)
+        return (PARSE_SYNTAX);
+    collectHeredocs(info);
+    if (n == -2)
+        return (PARSE_INCOMPLETE);
+    return (parseTokens(info, n, 0));
+}
+
+/**
+ * parseTokens - Parses the tokens of a lexed line into info->ast.
+ * @info: The parameter struct holding the tokens.
+ * @n: The number of tokens.
+ * @quiet: Non-zero to find syntax errors without reporting them, as
+ *         when a script is compiled ahead of running it.
+ *
+ * Return: PARSE_OK, PARSE_SYNTAX or PARSE_INCOMPLETE.
+ */
+int parseTokens(shell_info *info, int n, int quiet)
+{
+    parser_t p;
+    int root;
+
+    info->root = -1;
+    free(info->ast);
+    info->ast = malloc(sizeof(ast_node_t) * (2 * n + 1));
+    if (!info->ast)
+        return (PARSE_SYNTAX);
+
+    _memset((char *)&p, 0, sizeof(p));
+    p.tokens = info->tokens;
+    p.ntokens = n;
+    p.nodes = info->ast;
+    p.info = quiet ? NULL : info;
+    root = parseList(&p);
+    if (p.pos < p.ntokens)
+        parseError(&p);
+    if (!p.error)
+        info->root = root;
+    return (p.error);
+}
+
+/**
+ * continueLine - Appends the next input line to an incomplete one.
+ * @info: The parameter struct.
+ * @buf: Address of the line; it is replaced by the joined lines.
+ *
+ * Description: The lines are joined with a newline, which the lexer
+ * treats as a separator outside quotes; a line of a mapped script is
+ * usually extended in place instead (see extendLine()). At end of input
+ * the line is reported as a syntax error.
+ *
+ * Return: 0 on success, -1 at end of input or on failure.
+ */
+int continueLine(shell_info *info, char **buf)
+{
+    char *next = NULL, *joined;
+    size_t len = 0;
+    ssize_t got;
+
+    if (interactive(info))
+    {
+        _puts("> ");
+        _putchar(BUF_FLUSH);
+    }
+    if (extendLine(info, buf) == 0)
+        return (info->line_count++, 0);
+    got = custom_getline(info, &next, &len);
+    if (got > 0 && next[got - 1] == '\n')
+        next[--got] = '\0';
+    joined = got >= 0 ? malloc(_strlen(*buf) + got + 2) : NULL;
+    if (!joined)
+    {
+        free(next);
+        syntaxError(info, "end of file", -1);
+        return (-1);
+    }
+
+    _strcpy(joined, *buf);
+    _strcat(joined, "\n");
+    _strcat(joined, next);
+    freeLine(info, *buf);
+    free(next);
+    *buf = joined;
+    info->line_count++;
+    return (0);
+}
@@ -0,0 +1,132 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <sys/mman.h>
+
+/**
+ * mapInput - Maps a script so its lines can be used where they lie.
+ * @info: The parameter struct; info->readfd is the open script.
+ *
+ * Description: The mapping is private and writable, so a line can be
+ * NUL-terminated in place; only the pages written to are copied. It is
+ * one byte longer than the file, the extra byte coming from an anonymous
+ * mapping, so a last line without a newline is terminated too.
+ *
+ * Return: 0 on success, -1 if the input is not a non-empty regular file
+ *         or cannot be mapped.
+ */
+int mapInput(shell_info *info)
+{
+    struct stat st;
+    char *base;
+
+    if (fstat(info->readfd, &st) == -1 || !S_ISREG(st.st_mode) ||
+            st.st_size == 0)
+        return (-1);
+    base = mmap(NULL, st.st_size + 1, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+        return (-1);
+    if (mmap(base, st.st_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_FIXED, info->readfd, 0) == MAP_FAILED)
+    {
+        munmap(base, st.st_size + 1);
+        return (-1);
+    }
+    info->input_map = base;
+    info->input_size = st.st_size;
+    info->input_pos = 0;
+    return (0);
+}
+
+/**
+ * mapLine - Takes the next line of a mapped script.
+ * @info: The parameter struct holding the mapping.
+ * @line: Set to the line.
+ * @copy: If zero, the line is a slice of the mapping with its newline
+ *        replaced by a NUL; otherwise it is an allocated copy that keeps
+ *        the newline, as custom_getline() returns it.
+ *
+ * Return: Number of bytes consumed, newline included, or -1 at the end
+ *         of the script or on failure.
+ */
+ssize_t mapLine(shell_info *info, char **line, int copy)
+{
+    char *start = info->input_map + info->input_pos, *end;
+    size_t len;
+
+    if (info->input_pos >= info->input_size)
+        return (-1);
+    end = memchr(start, '\n', info->input_size - info->input_pos);
+    len = end ? (size_t)(end - start) + 1 : info->input_size - info->input_pos;
+    info->input_pos += len;
+    if (copy)
+    {
+        *line = malloc(len + 1);
+        if (!*line)
+            return (-1);
+        memcpy(*line, start, len);
+        (*line)[len] = '\0';
+        return (len);
+    }
+    if (end)
+        *end = '\0';
+    *line = start;
+    return (len);
+}
+
+/**
+ * extendLine - Continues a line of a mapped script in place.
+ * @info: The parameter struct holding the mapping.
+ * @buf: Address of the line.
+ *
+ * Description: When nothing was read since the line, such as the body
+ * of a here-document, the next line follows it in the mapping: putting
+ * back the newline between them joins them the way continueLine() does.
+ *
+ * Return: 0 if the line was extended, -1 if it must be joined by copying.
+ */
+int extendLine(shell_info *info, char **buf)
+{
+    char *end, *next;
+
+    if (!info->input_map || *buf < info->input_map ||
+            *buf >= info->input_map + info->input_size)
+        return (-1);
+    end = *buf + _strlen(*buf);
+    if (end + 1 != info->input_map + info->input_pos ||
+            info->input_pos >= info->input_size)
+        return (-1);
+    *end = '\n';
+    return (mapLine(info, &next, 0) == -1 ? -1 : 0);
+}
+
+/**
+ * freeLine - Frees an input line unless it is a slice of the mapping.
+ * @info: The parameter struct holding the mapping.
+ * @line: The line, or NULL.
+ *
+ * Return: void
+ */
+void freeLine(shell_info *info, char *line)
+{
+    if (info->input_map && line >= info->input_map &&
+            line <= info->input_map + info->input_size)
+        return;
+    free(line);
+}
+
+/**
+ * unmapInput - Unmaps the mapped script.
+ * @info: The parameter struct.
+ *
+ * Return: void
+ */
+void unmapInput(shell_info *info)
+{
+    if (!info->input_map)
+        return;
+    munmap(info->input_map, info->input_size + 1);
+    info->input_map = NULL;
+    info->input_size = 0;
+    info->input_pos = 0;
+}
@@ -0,0 +1,153 @@
+#include "shell.h"
+#include <signal.h>
+#include <stdlib.h>
+
+static int sigchld_pipe[2] = {-1, -1};
+static volatile sig_atomic_t sigchld_fired;
+
+/**
+ * sigchldHandler - Notes that a child changed state (self-pipe trick).
+ * @sig_num: The signal number (unused in this function).
+ *
+ * Description: Only a flag is set and a byte written here; the children
+ * are reaped by reapJobs() from the main loop, outside of signal context.
+ *
+ * Return: void
+ */
+void sigchldHandler(__attribute__((unused)) int sig_num)
+{
+    int saved_errno = errno;
+    ssize_t written = 0;
+
+    sigchld_fired = 1;
+    if (sigchld_pipe[1] != -1)
+        written = write(sigchld_pipe[1], "c", 1);
+    (void)written;
+    errno = saved_errno;
+}
+
+/**
+ * initJobs - Sets up SIGCHLD notification for background jobs.
+ *
+ * Description: SA_RESTART keeps reads of the next command line and
+ * waits for foreground commands from failing with EINTR. A forked shell
+ * calls it again to get a pipe that is not shared with its parent.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int initJobs(void)
+{
+    struct sigaction sa;
+
+    if (sigchld_pipe[0] != -1)
+    {
+        close(sigchld_pipe[0]);
+        close(sigchld_pipe[1]);
+    }
+    sigchld_fired = 0;
+    if (pipe2(sigchld_pipe, O_CLOEXEC | O_NONBLOCK) == -1)
+        return (-1);
+
+    _memset((char *)&sa, 0, sizeof(sa));
+    sa.sa_handler = sigchldHandler;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    return (sigaction(SIGCHLD, &sa, NULL));
+}
+
+/**
+ * addJob - Adds a running background job to the end of the job table.
+ * @info: The parameter struct holding the job table.
+ * @pid: The process id of the job.
+ * @cmd: The command line of the job.
+ *
+ * Return: The new job, or NULL on failure.
+ */
+job_t *addJob(shell_info *info, pid_t pid, char *cmd)
+{
+    job_t *job, **tail = &(info->jobs);
+    int id = 1;
+
+    for (; *tail; tail = &((*tail)->next))
+        if ((*tail)->id >= id)
+            id = (*tail)->id + 1;
+
+    job = malloc(sizeof(job_t));
+    if (!job)
+        return (NULL);
+    job->id = id;
+    job->pid = pid;
+    job->pidfd = pidfdOpen(pid);
+    job->state = JOB_RUNNING;
+    job->status = 0;
+    job->cmd = _strdup(cmd ? cmd : "");
+    job->next = NULL;
+    *tail = job;
+    return (job);
+}
+
+/**
+ * findJob - Finds a job from a job spec.
+ * @info: The parameter struct holding the job table.
+ * @spec: "%n" for job n, "%%" / "%+" / NULL for the current (newest) job,
+ *        or a process id.
+ *
+ * Return: The matching job, or NULL if there is none.
+ */
+job_t *findJob(shell_info *info, char *spec)
+{
+    job_t *job, *last = NULL;
+
+    for (job = info->jobs; job; job = job->next)
+    {
+        last = job;
+        if (!spec || !_strcmp(spec, "%%") || !_strcmp(spec, "%+"))
+            continue;
+        if (spec[0] == '%' && _erratoi(spec + 1) == job->id)
+            return (job);
+        if (spec[0] != '%' && _erratoi(spec) == job->pid)
+            return (job);
+    }
+
+    if (!spec || !_strcmp(spec, "%%") || !_strcmp(spec, "%+"))
+        return (last);
+    return (NULL);
+}
+
+/**
+ * reapJobs - Collects background jobs that changed state.
+ * @info: The parameter struct holding the job table.
+ *
+ * Description: Does nothing unless SIGCHLD fired since the last call,
+ * which the flag tells without a read() of the pipe for every line.
+ * Finished jobs are reported and dropped in interactive mode; scripts keep
+ * them until "wait" or "jobs" collects their status.
+ *
+ * Return: void
+ */
+void reapJobs(shell_info *info)
+{
+    char drain[64];
+    int status;
+    job_t *job, *next;
+
+    if (!sigchld_fired)
+        return;
+    sigchld_fired = 0;
+    while (sigchld_pipe[0] != -1 && read(sigchld_pipe[0], drain,
+                sizeof(drain)) > 0)
+        ;
+
+    for (job = info->jobs; job; job = next)
+    {
+        next = job->next;
+        if (job->state != JOB_DONE && waitPidfd(job->pidfd, job->pid,
+                    &status, WNOHANG | WUNTRACED | WCONTINUED) > 0)
+            updateJob(job, status);
+        if (job->state == JOB_DONE && interactive(info))
+        {
+            printJob(job);
+            removeJob(info, job);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * updateJob - Records a state change reported by waitpid().
+ * @job: The job to update.
+ * @status: The raw wait status.
+ *
+ * Description: Once the job is done its pidfd is closed: only the pid
+ * and the status are kept for "wait" and "jobs", so a script starting
+ * many jobs does not run out of descriptors.
+ *
+ * Return: void
+ */
+void updateJob(job_t *job, int status)
+{
+    if (WIFSTOPPED(status))
+        job->state = JOB_STOPPED;
+    else if (WIFCONTINUED(status))
+        job->state = JOB_RUNNING;
+    else
+    {
+        job->state = JOB_DONE;
+        job->status = exitStatus(status);
+        if (job->pidfd >= 0)
+            close(job->pidfd);
+        job->pidfd = -1;
+    }
+}
+
+/**
+ * removeJob - Unlinks a job from the job table and frees it.
+ * @info: The parameter struct holding the job table.
+ * @job: The job to remove.
+ *
+ * Return: void
+ */
+void removeJob(shell_info *info, job_t *job)
+{
+    job_t **link;
+
+    for (link = &(info->jobs); *link; link = &((*link)->next))
+        if (*link == job)
+        {
+            *link = job->next;
+            if (job->pidfd >= 0)
+                close(job->pidfd);
+            free(job->cmd);
+            free(job);
+            return;
+        }
+}
+
+/**
+ * printJob - Prints a job as "[id] State<TAB>command".
+ * @job: The job to print.
+ *
+ * Return: void
+ */
+void printJob(job_t *job)
+{
+    _putchar('[');
+    _puts(convert_number(job->id, 10, 0));
+    _puts("] ");
+    if (job->state == JOB_RUNNING)
+        _puts("Running");
+    else if (job->state == JOB_STOPPED)
+        _puts("Stopped");
+    else if (job->status == 0)
+        _puts("Done");
+    else
+    {
+        _puts("Exit ");
+        _puts(convert_number(job->status, 10, 0));
+    }
+    _putchar('\t');
+    _puts(job->cmd);
+    _putchar('\n');
+}
+
+/**
+ * freeJobs - Frees the whole job table.
+ * @info: The parameter struct holding the job table.
+ *
+ * Return: void
+ */
+void freeJobs(shell_info *info)
+{
+    while (info->jobs)
+        removeJob(info, info->jobs);
+}
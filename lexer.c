@@ -0,0 +1,183 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * lexOperator - Recognizes a control operator at a position of the line.
+ * @c: The position.
+ * @tok: Filled in with the operator's token.
+ *
+ * Description: A newline separates commands like ';' does; it is only
+ * found inside lines that were continued.
+ *
+ * Return: Length of the operator (1 or 2), or 0 if c is not one.
+ */
+int lexOperator(char *c, token_t *tok)
+{
+    int len = 1;
+
+    switch (*c)
+    {
+    case ';':
+        tok->type = TOK_SEMI;
+        break;
+    case '\n':
+        tok->type = TOK_NEWLINE;
+        break;
+    case '(':
+        tok->type = TOK_LPAREN;
+        break;
+    case ')':
+        tok->type = TOK_RPAREN;
+        break;
+    case '|':
+        tok->type = c[1] == '|' ? TOK_OR : TOK_PIPE;
+        len += c[1] == '|';
+        break;
+    case '&':
+        tok->type = c[1] == '&' ? TOK_AND : TOK_AMP;
+        len += c[1] == '&';
+        break;
+    default:
+        return (0);
+    }
+    tok->fd = -1;
+    tok->len = 0;
+    tok->word = NULL;
+    return (len);
+}
+
+/**
+ * lexRedir - Recognizes a redirection operator at a position of the line.
+ * @c: The position, on '<' or '>'.
+ * @word: The word running up to c, or NULL; made only of digits, it is
+ *        the descriptor ("2>") and becomes the redirection token itself.
+ * @tok: The token to fill in otherwise.
+ *
+ * Return: Length of the operator.
+ */
+int lexRedir(char *c, token_t *word, token_t *tok)
+{
+    static char *ops[] = {"<<<", "<<-", "<<", "<&", "<>", "<",
+        ">>", ">&", ">|", ">"};
+    int i, fd = 0;
+
+    for (i = 0; word && i < word->len && word->word[i] >= '0' &&
+            word->word[i] <= '9'; i++)
+        fd = fd * 10 + (word->word[i] - '0');
+    if (word && i == word->len)
+        tok = word;
+    else
+        fd = -1;
+
+    for (i = 0; !starts_with(c, ops[i]); i++)
+        ;
+    tok->type = TOK_REDIR;
+    tok->fd = fd;
+    tok->len = 0;
+    tok->word = ops[i];
+    return (_strlen(ops[i]));
+}
+
+/**
+ * skipQuoted - Finds the end of a quoted part of a word.
+ * @c: The position of the quote or backslash.
+ *
+ * Description: Inside double quotes a backslash still protects the next
+ * character, so "a\"b" is one quoted part.
+ *
+ * Return: The first character after the quoted part, or NULL if the line
+ *         ends before it is closed.
+ */
+char *skipQuoted(char *c)
+{
+    char quote = *c;
+
+    if (quote == '\\')
+        return (c[1] ? c + 2 : NULL);
+    for (c++; *c && *c != quote; c++)
+        if (quote == '"' && *c == '\\' && c[1])
+            c++;
+    return (*c ? c + 1 : NULL);
+}
+
+/**
+ * lexWord - Adds a character or a quoted part to the current word.
+ * @c: The position.
+ * @word: Address of the word being lexed; if it is NULL, a new word
+ *        starting at c is added to the tokens.
+ * @tokens: The token array.
+ * @n: Address of the number of tokens.
+ *
+ * Return: Number of characters consumed, or 0 if a quote is left open.
+ */
+int lexWord(char *c, token_t **word, token_t *tokens, int *n)
+{
+    char *end;
+
+    if (!*word)
+    {
+        *word = tokens + (*n)++;
+        (*word)->type = TOK_WORD;
+        (*word)->fd = -1;
+        (*word)->word = c;
+    }
+    end = is_delim(*c, "'\"\\") ? skipQuoted(c) : c + 1;
+    return (end ? end - c : 0);
+}
+
+/**
+ * lexLine - Splits a command line into tokens in a single pass.
+ * @info: The parameter struct; the tokens are stored in info->tokens.
+ * @line: The line; it is not modified, see finishTokens().
+ *
+ * Description: Comments, operators and word boundaries are all found in
+ * the same sweep. Quotes and backslashes only extend the word they are
+ * in and are kept in it; expandWord() removes them. Words are not
+ * copied: each word token points into line, which is remembered in
+ * info->arg so argv entries can be told apart from strings allocated by
+ * expansions. The token array is the only allocation.
+ *
+ * Return: The number of tokens, -1 on allocation failure, or -2 if a
+ *         quote is left open (info->ntokens still counts the tokens).
+ */
+int lexLine(shell_info *info, char *line)
+{
+    size_t size = _strlen(line) + 1;
+    token_t *tokens = malloc(sizeof(token_t) * size), *word = NULL;
+    int n = 0, len;
+    char *c;
+
+    free(info->tokens);
+    info->tokens = tokens;
+    info->ntokens = 0;
+    info->arg = line;
+    info->arg_size = size;
+    if (!tokens)
+        return (-1);
+
+    for (c = line; *c; c += len)
+    {
+        if (word && is_delim(*c, " \t\n;&|()<>"))
+        {
+            word->len = c - word->word;
+            word = *c == '<' || *c == '>' ? word : NULL;
+        }
+        if (*c == '#' && !word)
+            len = _strchr(c, '\n') ? _strchr(c, '\n') - c : _strlen(c);
+        else if (*c == '<' || *c == '>')
+        {
+            len = lexRedir(c, word, tokens + n);
+            n += !word || word->type != TOK_REDIR;
+            word = NULL;
+        }
+        else if (!(len = lexOperator(c, tokens + n)) && is_delim(*c, " \t"))
+            len = 1;
+        else if (len)
+            n++;
+        else if (!(len = lexWord(c, &word, tokens, &n)))
+            return (word->len = _strlen(word->word), info->ntokens = n, -2);
+    }
+    if (word)
+        word->len = c - word->word;
+    return (info->ntokens = n);
+}
@@ -11,8 +11,11 @@ int main(int ac, char **av)
 {
 	shell_info info[] = { INFO_INIT };
 	int fd = 2;
+	char *serve = NULL;
 
-	if (ac == 2)
+	if (ac == 3 && !_strcmp(av[1], "--serve"))
+		serve = av[2];
+	else if (ac == 2)
 	{
 		fd = open(av[1], O_RDONLY);
 		if (fd == -1)
@@ -32,8 +35,16 @@ int main(int ac, char **av)
 		}
 		info->readfd = fd;
 	}
+    clock_gettime(CLOCK_MONOTONIC, &info->started);
+    startZygote(info);
+    startPrefetch(info);
+    initJobs();
     populateEnvList(info);
     load_command_history(info);
+    if (fd > 2 && loadScript(info, av[1]) == -1)
+        mapInput(info);
+    if (serve)
+        return (serveShell(info, av, serve));
     execShell(info, av);
 	return (EXIT_SUCCESS);
 }
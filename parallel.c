@@ -0,0 +1,153 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * parseParallel - Parses "parallel [-j N] [-k] command [args] [::: inputs]".
+ * @info: Structure containing potential arguments.
+ * @p: The parallel state to fill in.
+ *
+ * Description: Without ":::" the inputs are read from stdin, one per line.
+ *
+ * Return: 0 on success, -1 on a usage error.
+ */
+int parseParallel(shell_info *info, parallel_t *p)
+{
+    int i;
+
+    _memset((char *)p, 0, sizeof(*p));
+    p->max_jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (p->max_jobs < 1)
+        p->max_jobs = 1;
+    for (i = 1; info->argv[i] && info->argv[i][0] == '-'; i++)
+    {
+        if (_strcmp(info->argv[i], "-k") == 0)
+            p->keep_order = 1;
+        else if (_strcmp(info->argv[i], "-j") == 0 && info->argv[i + 1] &&
+                _erratoi(info->argv[i + 1]) > 0)
+            p->max_jobs = _erratoi(info->argv[++i]);
+        else if (starts_with(info->argv[i], "-j") &&
+                _erratoi(info->argv[i] + 2) > 0)
+            p->max_jobs = _erratoi(info->argv[i] + 2);
+        else
+            return (-1);
+    }
+    if (!info->argv[i] || _strcmp(info->argv[i], ":::") == 0)
+        return (-1);
+
+    p->cmd = &(info->argv[i]);
+    while (info->argv[i] && _strcmp(info->argv[i], ":::"))
+        i++;
+    if (info->argv[i])
+    {
+        p->inputs = &(info->argv[i + 1]);
+        p->count = info->argc - i - 1;
+        return (0);
+    }
+    p->owned = 1;
+    p->inputs = readParallelInput(STDIN_FILENO, &(p->count));
+    return (0);
+}
+
+/**
+ * readParallelInput - Reads the inputs of parallel, one per line.
+ * @fd: The file descriptor to read until end of file.
+ * @count: Where to store the number of inputs.
+ *
+ * Return: Allocated NULL-terminated array of inputs, or NULL if empty.
+ */
+char **readParallelInput(int fd, int *count)
+{
+    char *buf = NULL, *grown, **inputs;
+    size_t len = 0, size = 0;
+    ssize_t got = 1;
+
+    while (got > 0)
+    {
+        if (len + READ_BUF_SIZE + 1 > size)
+        {
+            grown = reAllocate(buf, size, size * 2 + READ_BUF_SIZE + 1);
+            if (!grown)
+                break;
+            buf = grown;
+            size = size * 2 + READ_BUF_SIZE + 1;
+        }
+        got = read(fd, buf + len, READ_BUF_SIZE);
+        if (got > 0)
+            len += got;
+    }
+    if (!buf)
+        return (*count = 0, NULL);
+    buf[len] = '\0';
+    inputs = strtow(buf, "\n");
+    free(buf);
+    for (*count = 0; inputs && inputs[*count]; (*count)++)
+        ;
+    return (inputs);
+}
+
+/**
+ * freeParallel - Releases the buffers of a parallel run.
+ * @p: The parallel state.
+ *
+ * Return: void
+ */
+void freeParallel(parallel_t *p)
+{
+    if (p->owned)
+        ffree(p->inputs);
+    free(p->pids);
+    free(p->outfds);
+    free(p->errfds);
+    free(p->slots);
+    free(p->slot_job);
+}
+
+/**
+ * shell_parallel - Runs a command once per input with a bounded pool.
+ * @info: Structure containing potential arguments.
+ *
+ * Description: "parallel [-j N] [-k] command [args] ::: inputs..." keeps
+ * up to N jobs (default: online CPUs) in flight. The output and errors
+ * of each job are printed as a whole once it finishes, in input order
+ * with -k. The status of each job is stored in $PIPESTATUS.
+ *
+ * Return: The number of failed jobs (at most 101), 127 if the command
+ *         cannot be found, 255 on usage errors.
+ */
+int shell_parallel(shell_info *info)
+{
+    parallel_t p;
+    int n;
+
+    if (parseParallel(info, &p) == -1)
+    {
+        _eputs("parallel: usage: parallel [-j N] [-k] command [args] ");
+        _eputs("[::: inputs...]\n");
+        return (info->status = 255);
+    }
+    p.path = resolveCmd(info, p.cmd[0]);
+    if (!p.path && isCmd(info, p.cmd[0]))
+        p.path = p.cmd[0];
+    if (!p.path)
+    {
+        print_error(info, p.cmd[0]);
+        _eputs(": not found\n");
+        return (freeParallel(&p), info->status = 127);
+    }
+    n = p.count > 0 ? p.count : 1;
+    p.max_jobs = p.max_jobs < n ? p.max_jobs : n;
+    p.pids = malloc(sizeof(pid_t) * n);
+    p.outfds = malloc(sizeof(int) * n);
+    p.errfds = malloc(sizeof(int) * n);
+    p.slots = malloc(sizeof(struct pollfd) * p.max_jobs);
+    p.slot_job = malloc(sizeof(int) * p.max_jobs);
+    free(info->pipestatus);
+    info->pipestatus = malloc(sizeof(int) * n);
+    info->pipecount = info->pipestatus ? p.count : 0;
+    if (!p.pids || !p.outfds || !p.errfds || !p.slots || !p.slot_job ||
+            !info->pipestatus)
+        return (freeParallel(&p), info->status = 1);
+    info->status = runParallel(info, &p);
+    freeParallel(&p);
+    return (info->status);
+}
@@ -0,0 +1,59 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * replaceInput - Copies an argument with every "{}" in it replaced.
+ * @arg: The argument of the command template.
+ * @input: The input of the job.
+ *
+ * Return: The allocated argument, or NULL on failure.
+ */
+char *replaceInput(char *arg, char *input)
+{
+    size_t len = _strlen(arg), inlen = _strlen(input), n = 0;
+    char *at, *out, *dst;
+
+    for (at = strstr(arg, "{}"); at; at = strstr(at + 2, "{}"))
+        n++;
+    out = malloc(len - 2 * n + n * inlen + 1);
+    if (!out)
+        return (NULL);
+    for (dst = out; (at = strstr(arg, "{}")); arg = at + 2)
+    {
+        memcpy(dst, arg, at - arg);
+        dst += at - arg;
+        memcpy(dst, input, inlen);
+        dst += inlen;
+    }
+    _strcpy(dst, arg);
+    return (out);
+}
+
+/**
+ * buildJobArgv - Builds the argument vector of one job.
+ * @p: The parallel state holding the command template.
+ * @input: The input of the job; it replaces every "{}" in the words of
+ *         the template, or is appended when none of them has one, as
+ *         GNU parallel does.
+ *
+ * Return: Allocated NULL-terminated argv, or NULL on failure.
+ */
+char **buildJobArgv(parallel_t *p, char *input)
+{
+    int i, words, placeholder = 0;
+    char **argv;
+
+    for (words = 0; p->cmd[words] && _strcmp(p->cmd[words], ":::"); words++)
+        if (strstr(p->cmd[words], "{}"))
+            placeholder = 1;
+
+    argv = malloc(sizeof(char *) * (words + 2));
+    if (!argv)
+        return (NULL);
+    for (i = 0; i < words; i++)
+        argv[i] = replaceInput(p->cmd[i], input);
+    if (!placeholder)
+        argv[i++] = _strdup(input);
+    argv[i] = NULL;
+    return (argv);
+}
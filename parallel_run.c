@@ -0,0 +1,163 @@
+#include "shell.h"
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+
+/**
+ * startParallelJob - Spawns one job with its stdout and stderr each
+ *                    captured in a memfd.
+ * @info: The parameter struct, used for the environment.
+ * @p: The parallel state.
+ * @job: Index of the job to start.
+ * @slot: The free slot the job runs in.
+ *
+ * Description: If no pidfd can be obtained the job is waited for at
+ * once, so the run degrades to one job at a time.
+ *
+ * Return: 0 if the job is running in the slot, -1 if it already ended.
+ */
+int startParallelJob(shell_info *info, parallel_t *p, int job, int slot)
+{
+    posix_spawn_file_actions_t actions;
+    char **argv = buildJobArgv(p, p->inputs[job]);
+    int pidfd;
+
+    p->outfds[job] = memfd_create("parallel", MFD_CLOEXEC);
+    p->errfds[job] = memfd_create("parallel", MFD_CLOEXEC);
+    info->pipestatus[job] = 127;
+    posix_spawn_file_actions_init(&actions);
+    if (p->outfds[job] != -1)
+        posix_spawn_file_actions_adddup2(&actions, p->outfds[job],
+                STDOUT_FILENO);
+    if (p->errfds[job] != -1)
+        posix_spawn_file_actions_adddup2(&actions, p->errfds[job],
+                STDERR_FILENO);
+    p->pids[job] = argv ? spawnProcess(info, p->path, argv, &actions) : -1;
+    posix_spawn_file_actions_destroy(&actions);
+    ffree(argv);
+    if (p->pids[job] == -1)
+    {
+        print_error(info, p->cmd[0]);
+        _eputs(": cannot run\n");
+    }
+
+    pidfd = p->pids[job] > 0 ? pidfdOpen(p->pids[job]) : -1;
+    if (pidfd == -1)
+    {
+        finishParallelJob(info, p, job, -1);
+        return (-1);
+    }
+    p->slots[slot].fd = pidfd;
+    p->slot_job[slot] = job;
+    return (0);
+}
+
+/**
+ * copyCaptured - Copies what a job wrote to a memfd, then closes it.
+ * @fd: Where the captured output is kept; set to -1 once copied.
+ * @to: The file descriptor to copy it to.
+ *
+ * Description: sendfile() moves the data without a userspace copy; a
+ * read/write loop covers outputs sendfile() cannot write to.
+ *
+ * Return: void
+ */
+void copyCaptured(int *fd, int to)
+{
+    char buf[READ_BUF_SIZE];
+    ssize_t n;
+
+    if (*fd < 0)
+        return;
+    lseek(*fd, 0, SEEK_SET);
+    while ((n = sendfile(to, *fd, NULL, 1 << 20)) > 0)
+        ;
+    while (n == -1 && (n = read(*fd, buf, sizeof(buf))) > 0)
+        if (write(to, buf, n) != n)
+            break;
+    close(*fd);
+    *fd = -1;
+}
+
+/**
+ * flushParallelOutput - Prints the captured output of a job, then its
+ *                       errors.
+ * @p: The parallel state.
+ * @job: Index of the finished job.
+ *
+ * Return: void
+ */
+void flushParallelOutput(parallel_t *p, int job)
+{
+    _putchar(BUF_FLUSH);
+    _buffered_err_putchar(BUF_FLUSH);
+    copyCaptured(p->outfds + job, STDOUT_FILENO);
+    copyCaptured(p->errfds + job, STDERR_FILENO);
+}
+
+/**
+ * finishParallelJob - Reaps a job and prints whatever output is due.
+ * @info: The parameter struct; the status goes to info->pipestatus.
+ * @p: The parallel state.
+ * @job: Index of the job.
+ * @pidfd: The pidfd of the job, or -1; it is closed here.
+ *
+ * Return: void
+ */
+void finishParallelJob(shell_info *info, parallel_t *p, int job, int pidfd)
+{
+    int status;
+
+    if (p->pids[job] > 0 && waitPidfd(pidfd, p->pids[job], &status, 0) > 0)
+        info->pipestatus[job] = exitStatus(status);
+    if (pidfd >= 0)
+        close(pidfd);
+    p->pids[job] = 0;
+
+    if (!p->keep_order)
+        flushParallelOutput(p, job);
+    while (p->keep_order && p->next_out < p->count &&
+            p->pids[p->next_out] == 0)
+        flushParallelOutput(p, p->next_out++);
+}
+
+/**
+ * runParallel - Keeps up to max_jobs jobs in flight until all are done.
+ * @info: The parameter struct.
+ * @p: The parallel state.
+ *
+ * Return: The number of failed jobs, at most 101.
+ */
+int runParallel(shell_info *info, parallel_t *p)
+{
+    int i, slot, next = 0, running = 0, failed = 0;
+
+    for (i = 0; i < p->count; i++)
+        p->pids[i] = -1, p->outfds[i] = p->errfds[i] = -1;
+    for (slot = 0; slot < p->max_jobs; slot++)
+        p->slots[slot].fd = -1, p->slots[slot].events = POLLIN;
+
+    while (next < p->count || running)
+    {
+        for (slot = 0; slot < p->max_jobs && next < p->count; slot++)
+            if (p->slots[slot].fd == -1 &&
+                    startParallelJob(info, p, next++, slot) == 0)
+                running++;
+        if (!running)
+            continue;
+        if (poll(p->slots, p->max_jobs, -1) == -1 && errno != EINTR)
+            break;
+        for (slot = 0; slot < p->max_jobs; slot++)
+            if (p->slots[slot].fd >= 0 && p->slots[slot].revents)
+            {
+                finishParallelJob(info, p, p->slot_job[slot],
+                        p->slots[slot].fd);
+                p->slots[slot].fd = -1;
+                running--;
+            }
+    }
+
+    for (i = 0; i < p->count; i++)
+        if (info->pipestatus[i])
+            failed++;
+    return (failed > 101 ? 101 : failed);
+}
@@ -0,0 +1,163 @@
+#include "shell.h"
+
+/**
+ * parseList - Parses and-or chains separated by ';', '&' or newlines.
+ * @p: The parser.
+ *
+ * Description: The list ends at the end of the tokens, at ')' or at a
+ * "}" word; the caller checks which. "a & b" becomes SEQ(BG(a), b).
+ *
+ * Return: The root node of the list, or -1 if it is empty or on error.
+ */
+int parseList(parser_t *p)
+{
+    int list = -1, node, first = p->pos, start, type;
+
+    while (!p->error && p->pos < p->ntokens)
+    {
+        type = p->tokens[p->pos].type;
+        if (type == TOK_RPAREN || tokenIs(p, "}"))
+            break;
+        if (type == TOK_NEWLINE)
+        {
+            p->pos++;
+            continue;
+        }
+        start = p->pos;
+        node = parseAndOr(p);
+        if (p->error)
+            break;
+        type = p->pos < p->ntokens ? p->tokens[p->pos].type : TOK_NEWLINE;
+        if (type == TOK_SEMI || type == TOK_AMP || type == TOK_NEWLINE)
+            p->pos += p->pos < p->ntokens;
+        else if (type != TOK_RPAREN && !tokenIs(p, "}"))
+            parseError(p);
+        if (type == TOK_AMP)
+            node = newNode(p, AST_BG, node, -1, start);
+        list = list < 0 ? node : newNode(p, AST_SEQ, list, node, first);
+    }
+    return (p->error ? -1 : list);
+}
+
+/**
+ * parseAndOr - Parses pipelines joined by && and ||.
+ * @p: The parser.
+ *
+ * Description: Both operators have the same precedence and group to the
+ * left, so "a && b || c" runs c when a or b fails.
+ *
+ * Return: The root node of the chain.
+ */
+int parseAndOr(parser_t *p)
+{
+    int start = p->pos, left = parsePipeline(p), right, type;
+
+    while (!p->error && p->pos < p->ntokens)
+    {
+        type = p->tokens[p->pos].type;
+        if (type != TOK_AND && type != TOK_OR)
+            break;
+        p->pos++;
+        right = parsePipeline(p);
+        left = newNode(p, type == TOK_AND ? AST_AND : AST_OR, left, right,
+                start);
+    }
+    return (left);
+}
+
+/**
+ * parsePipeline - Parses commands joined by '|', with "!" or "time".
+ * @p: The parser.
+ *
+ * Description: "time" with no command after it reports the previous
+ * command line again.
+ *
+ * Return: The root node of the pipeline.
+ */
+int parsePipeline(parser_t *p)
+{
+    int start = p->pos, left = -1, right, type;
+
+    if (tokenIs(p, "!") || tokenIs(p, "time"))
+    {
+        type = tokenIs(p, "!") ? AST_NOT : AST_TIME;
+        p->pos++;
+        right = p->pos < p->ntokens ? p->tokens[p->pos].type : TOK_NEWLINE;
+        if (type == AST_NOT || right == TOK_WORD || right == TOK_REDIR ||
+                right == TOK_LPAREN)
+            left = parsePipeline(p);
+        return (newNode(p, type, left, -1, start));
+    }
+
+    left = parseCommand(p);
+    while (!p->error && p->pos < p->ntokens &&
+            p->tokens[p->pos].type == TOK_PIPE)
+    {
+        p->pos++;
+        right = parseCommand(p);
+        left = newNode(p, AST_PIPE, left, right, start);
+    }
+    return (left);
+}
+
+/**
+ * parseCommand - Parses a simple command, a subshell or a group.
+ * @p: The parser.
+ *
+ * Description: Newlines before the command are skipped, so a line may
+ * end with '|', && or || and go on with the next one. A simple command
+ * is a run of words and redirections.
+ *
+ * Return: The node of the command.
+ */
+int parseCommand(parser_t *p)
+{
+    int start;
+
+    while (p->pos < p->ntokens && p->tokens[p->pos].type == TOK_NEWLINE)
+        p->pos++;
+    start = p->pos;
+    if (p->pos < p->ntokens && (p->tokens[p->pos].type == TOK_LPAREN ||
+                tokenIs(p, "{")))
+        return (parseCompound(p));
+
+    while (p->pos < p->ntokens && !p->error)
+    {
+        if (p->tokens[p->pos].type == TOK_WORD)
+            p->pos++;
+        else if (!parseRedir(p))
+            break;
+    }
+    if (p->pos == start || (p->pos < p->ntokens &&
+                p->tokens[p->pos].type == TOK_LPAREN))
+        parseError(p);
+    return (newNode(p, AST_CMD, -1, -1, start));
+}
+
+/**
+ * parseCompound - Parses "( list )" or "{ list; }" and its redirections.
+ * @p: The parser, on the "(" or "{".
+ *
+ * Description: A subshell runs its list in a child, so cd or exit in it
+ * do not reach the shell; a group runs it in the shell itself.
+ *
+ * Return: The AST_SUBSHELL or AST_GROUP node.
+ */
+int parseCompound(parser_t *p)
+{
+    int start = p->pos, end, body;
+    int paren = p->tokens[p->pos].type == TOK_LPAREN;
+
+    p->pos++;
+    body = parseList(p);
+    if (!p->error && (body < 0 || p->pos >= p->ntokens || (paren ?
+                    p->tokens[p->pos].type != TOK_RPAREN : !tokenIs(p, "}"))))
+        parseError(p);
+    if (p->error)
+        return (-1);
+
+    end = ++p->pos;
+    while (parseRedir(p))
+        ;
+    return (newNode(p, paren ? AST_SUBSHELL : AST_GROUP, body, end, start));
+}
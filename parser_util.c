@@ -0,0 +1,125 @@
+#include "shell.h"
+
+/**
+ * newNode - Adds a node to the syntax tree.
+ * @p: The parser; the node covers the tokens from tok up to p->pos.
+ * @type: The AST_* type.
+ * @left: The first child, or -1.
+ * @right: The second child, or -1.
+ * @tok: Index of the first token of the node.
+ *
+ * Return: Index of the node, or -1 once an error was found.
+ */
+int newNode(parser_t *p, int type, int left, int right, int tok)
+{
+    ast_node_t *node = p->nodes + p->nnodes;
+
+    if (p->error)
+        return (-1);
+    node->type = type;
+    node->left = left;
+    node->right = right;
+    node->tok = tok;
+    node->ntok = p->pos - tok;
+    return (p->nnodes++);
+}
+
+/**
+ * tokenIs - Checks whether the next token is a given word.
+ * @p: The parser.
+ * @word: The word, e.g. a reserved word such as "{" or "time".
+ *
+ * Description: Reserved words are only recognized where a command may
+ * start, and only unquoted, so "echo {" and "'time' x" are plain words.
+ *
+ * Return: 1 if it is, 0 otherwise.
+ */
+int tokenIs(parser_t *p, char *word)
+{
+    token_t *tok = p->tokens + p->pos;
+
+    return (p->pos < p->ntokens && tok->type == TOK_WORD &&
+            tok->len == _strlen(word) && !strncmp(tok->word, word, tok->len));
+}
+
+/**
+ * parseRedir - Consumes a redirection and its target word.
+ * @p: The parser.
+ *
+ * Return: 1 if one was consumed, 0 if the next token is not a
+ *         redirection or its target is missing (p->error is set).
+ */
+int parseRedir(parser_t *p)
+{
+    if (p->error || p->pos >= p->ntokens ||
+            p->tokens[p->pos].type != TOK_REDIR)
+        return (0);
+
+    p->pos++;
+    if (p->pos < p->ntokens && p->tokens[p->pos].type == TOK_WORD)
+        return (p->pos++, 1);
+    if (p->pos < p->ntokens)
+        parseError(p);
+    else
+    {
+        p->error = PARSE_SYNTAX;
+        syntaxError(p->info, "newline", -1);
+    }
+    return (0);
+}
+
+/**
+ * parseError - Stops parsing at the next token.
+ * @p: The parser.
+ *
+ * Description: Running out of tokens is not an error yet: the line is
+ * incomplete and may be continued on the next one.
+ *
+ * Return: void
+ */
+void parseError(parser_t *p)
+{
+    token_t *tok = p->tokens + p->pos;
+
+    if (p->error)
+        return;
+    if (p->pos >= p->ntokens)
+    {
+        p->error = PARSE_INCOMPLETE;
+        return;
+    }
+
+    p->error = PARSE_SYNTAX;
+    if (tok->type == TOK_NEWLINE)
+        syntaxError(p->info, "newline", -1);
+    else if (tok->type == TOK_WORD)
+        syntaxError(p->info, tok->word, tok->len);
+    else
+        syntaxError(p->info, tokenText(tok), _strlen(tokenText(tok)));
+}
+
+/**
+ * syntaxError - Reports a syntax error and sets the status to 2.
+ * @info: The parameter struct, NULL when parsing quietly.
+ * @what: What was found instead of what the grammar expects.
+ * @len: Length of what to print in quotes, or -1 to print it as is.
+ *
+ * Return: void
+ */
+void syntaxError(shell_info *info, char *what, int len)
+{
+    int i;
+
+    if (!info)
+        return;
+    info->status = 2;
+    _eputs(info->fname);
+    _eputs(": ");
+    print_d(info->line_count, STDERR_FILENO);
+    _eputs(": Syntax error: ");
+    if (len < 0)
+        _eputs(what);
+    for (i = 0; len >= 0 && i <= len + 1; i++)
+        _buffered_err_putchar(i == 0 || i == len + 1 ? '"' : what[i - 1]);
+    _eputs(" unexpected\n");
+}
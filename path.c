@@ -84,4 +84,34 @@ char *findPath(shell_info *info, char *pathstr, char *cmd)
         i++;
     }
     return (NULL);
-}
\ No newline at end of file
+}
+
+/**
+ * resolveCmd - Resolves a command through the hash table, then PATH
+ * @info: The info struct
+ * @cmd: The cmd to find
+ *
+ * Return: Full path of cmd if found or NULL
+ */
+char *resolveCmd(shell_info *info, char *cmd)
+{
+    char *path;
+    list_t *node;
+
+    if (_strchr(cmd, '/'))
+        return (findPath(info, getEnvironment(info, "PATH="), cmd));
+
+    path = hashLookup(info, cmd);
+    if (path)
+        return (path);
+
+    path = findPath(info, getEnvironment(info, "PATH="), cmd);
+    if (!path)
+        return (NULL);
+
+    node = hashInsert(info, cmd, path);
+    if (!node)
+        return (path);
+    node->num++;
+    return (_strchr(node->str, '=') + 1);
+}
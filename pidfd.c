@@ -0,0 +1,134 @@
+#include "shell.h"
+#include <signal.h>
+#include <sys/syscall.h>
+#include <linux/sched.h>
+
+/**
+ * pidfdOpen - Obtains a process file descriptor for a child.
+ * @pid: The child process id.
+ *
+ * Description: The pidfd refers to exactly this process, even if its pid
+ * is later reused, and can be polled for exit. It is close-on-exec.
+ *
+ * Return: The pidfd, or -1 if the kernel does not support it.
+ */
+int pidfdOpen(pid_t pid)
+{
+#ifdef SYS_pidfd_open
+    if (pid > 0)
+        return ((int)syscall(SYS_pidfd_open, pid, 0));
+#endif
+    (void)pid;
+    errno = ENOSYS;
+    return (-1);
+}
+
+/**
+ * forkPidfd - Forks a child and obtains its pidfd atomically.
+ * @pidfd: Where to store the pidfd of the child, -1 if unavailable.
+ *
+ * Description: Uses clone3(CLONE_PIDFD) where the kernel provides it and
+ * falls back to fork() followed by pidfd_open().
+ *
+ * Return: Like fork(): 0 in the child, the child's pid in the parent,
+ *         or -1 on failure.
+ */
+pid_t forkPidfd(int *pidfd)
+{
+    pid_t pid;
+#if defined(SYS_clone3) && defined(CLONE_PIDFD)
+    struct clone_args args;
+
+    _memset((char *)&args, 0, sizeof(args));
+    args.flags = CLONE_PIDFD;
+    args.pidfd = (unsigned long)pidfd;
+    args.exit_signal = SIGCHLD;
+    *pidfd = -1;
+    pid = (pid_t)syscall(SYS_clone3, &args, sizeof(args));
+    if (pid != -1 || (errno != ENOSYS && errno != EPERM))
+        return (pid);
+#endif
+    pid = fork();
+    *pidfd = pid > 0 ? pidfdOpen(pid) : -1;
+    return (pid);
+}
+
+/**
+ * siginfoStatus - Encodes a waitid() result as a waitpid() status.
+ * @si: The siginfo filled in by waitid().
+ *
+ * Description: Lets the W* macros and exitStatus() work unchanged.
+ *
+ * Return: The equivalent raw wait status.
+ */
+int siginfoStatus(siginfo_t *si)
+{
+    switch (si->si_code)
+    {
+    case CLD_EXITED:
+        return ((si->si_status & 0xff) << 8);
+    case CLD_KILLED:
+        return (si->si_status & 0x7f);
+    case CLD_DUMPED:
+        return ((si->si_status & 0x7f) | 0x80);
+    case CLD_STOPPED:
+    case CLD_TRAPPED:
+        return (((si->si_status & 0xff) << 8) | 0x7f);
+    default:
+        return (0xffff);
+    }
+}
+
+/**
+ * waitPidfd - Waits for a state change of exactly one child.
+ * @pidfd: The pidfd of the child, or -1 to wait by pid.
+ * @pid: The pid of the child.
+ * @status: Where to store the raw wait status.
+ * @options: waitpid() options (WNOHANG, WUNTRACED, WCONTINUED).
+ *
+ * Return: pid if the child changed state, 0 if WNOHANG found nothing,
+ *         or -1 on error.
+ */
+pid_t waitPidfd(int pidfd, pid_t pid, int *status, int options)
+{
+    return (waitUsage(pidfd, pid, status, options, NULL));
+}
+
+/**
+ * waitUsage - Waits for one child and collects the resources it used.
+ * @pidfd: The pidfd of the child, or -1 to wait by pid.
+ * @pid: The pid of the child.
+ * @status: Where to store the raw wait status.
+ * @options: waitpid() options (WNOHANG, WUNTRACED, WCONTINUED).
+ * @usage: Filled with the child's rusage once it has exited, or NULL.
+ *
+ * Description: The glibc waitid() wrapper drops the rusage argument of
+ * the system call, so it is called directly; without a pidfd, wait4()
+ * does the same job.
+ *
+ * Return: pid if the child changed state, 0 if WNOHANG found nothing,
+ *         or -1 on error.
+ */
+pid_t waitUsage(int pidfd, pid_t pid, int *status, int options,
+        struct rusage *usage)
+{
+    siginfo_t si;
+    long ret;
+
+    do {
+        if (pidfd < 0)
+            ret = wait4(pid, status, options, usage);
+        else
+        {
+            si.si_pid = 0;
+            ret = syscall(SYS_waitid, P_PIDFD, pidfd, &si, options | WEXITED,
+                    usage);
+            if (ret == 0 && si.si_pid == 0)
+                return (0);
+            if (ret == 0)
+                *status = siginfoStatus(&si), ret = pid;
+        }
+    } while (ret == -1 && errno == EINTR);
+
+    return ((pid_t)ret);
+}
@@ -0,0 +1,165 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * countPipeStages - Counts the stages of a pipeline.
+ * @info: The parameter struct holding the syntax tree.
+ * @n: The AST_PIPE node; "a | b | c" is PIPE(PIPE(a, b), c).
+ *
+ * Return: The number of stages.
+ */
+int countPipeStages(shell_info *info, int n)
+{
+    int stages = 1;
+
+    for (; info->ast[n].type == AST_PIPE; n = info->ast[n].left)
+        stages++;
+
+    return (stages);
+}
+
+/**
+ * setPipeSize - Resizes a pipe when PIPESIZE is set in the environment.
+ * @info: The parameter struct holding the environment list.
+ * @fd: Either end of the pipe.
+ *
+ * Description: Large pipes let a high-throughput producer run ahead of its
+ * consumer. Failures are ignored; the kernel default is kept.
+ *
+ * Return: void
+ */
+void setPipeSize(shell_info *info, int fd)
+{
+    char *size = getEnvironment(info, PIPE_SIZE_VAR);
+
+#ifdef F_SETPIPE_SZ
+    if (size && _atoi(size) > 0)
+        fcntl(fd, F_SETPIPE_SZ, _atoi(size));
+#else
+    (void)size;
+    (void)fd;
+#endif
+}
+
+/**
+ * waitStages - Collects the exit status of every stage of a pipeline.
+ * @info: The parameter struct; statuses are stored in info->pipestatus.
+ * @pids: Child of each stage, or -1 for a stage that never started.
+ * @stages: pidfd of each stage (-1 if unavailable), closed here.
+ * @count: The number of stages.
+ *
+ * Description: All pidfds are polled together, so stages are reaped in
+ * the order they exit rather than one after another. The rusage of every
+ * stage is added to the figures of the time keyword.
+ *
+ * Return: The status of the last stage.
+ */
+int waitStages(shell_info *info, pid_t *pids, struct pollfd *stages,
+        int count)
+{
+    struct rusage usage;
+    int i, status, pending = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        stages[i].events = POLLIN;
+        if (pids[i] > 0 && stages[i].fd >= 0)
+            pending++;
+    }
+
+    prefetchLine(info, -1);
+    while (pending > 0 && poll(stages, count, -1) != -1)
+        for (i = 0; i < count; i++)
+            if (stages[i].fd >= 0 && stages[i].revents)
+            {
+                if (waitUsage(stages[i].fd, pids[i], &status, 0, &usage) > 0)
+                {
+                    info->pipestatus[i] = exitStatus(status);
+                    addUsage(info, &usage);
+                }
+                close(stages[i].fd);
+                stages[i].fd = -1;
+                pids[i] = -1;
+                pending--;
+            }
+
+    for (i = 0; i < count; i++)
+        if (pids[i] > 0 && waitUsage(-1, pids[i], &status, 0, &usage) > 0)
+        {
+            info->pipestatus[i] = exitStatus(status);
+            addUsage(info, &usage);
+        }
+
+    return (info->pipestatus[count - 1]);
+}
+
+/**
+ * runPipeline - Runs "cmd | cmd | ..." with every stage started at once.
+ * @info: The parameter & return info struct.
+ * @av: The argument vector from main().
+ * @n: The AST_PIPE node.
+ *
+ * Return: The exit status of the last stage.
+ */
+int runPipeline(shell_info *info, char **av, int n)
+{
+    int i, count = countPipeStages(info, n), fds[2], in_fd = -1, *nodes;
+    struct pollfd *stages = malloc((sizeof(*stages) + sizeof(pid_t) +
+                sizeof(int)) * count);
+    pid_t *pids = (pid_t *)(stages + count);
+
+    info->fname = av[0];
+    free(info->pipestatus);
+    info->pipestatus = malloc(sizeof(int) * count);
+    info->pipecount = count;
+    if (!stages || !info->pipestatus)
+        return (free(stages), info->pipecount = 0, info->status = 1);
+    nodes = (int *)(pids + count);
+    for (i = count - 1; i >= 0; i--, n = info->ast[n].left)
+        nodes[i] = info->ast[n].type == AST_PIPE ? info->ast[n].right : n;
+
+    for (i = 0; i < count; i++)
+    {
+        fds[0] = fds[1] = -1;
+        if (i < count - 1 && pipe2(fds, O_CLOEXEC) == 0)
+            setPipeSize(info, fds[1]);
+        pids[i] = startStage(info, av, nodes[i], in_fd, fds[1]);
+        stages[i].fd = pids[i] > 0 ? pidfdOpen(pids[i]) : -1;
+        info->pipestatus[i] = info->status;
+        if (in_fd != -1)
+            close(in_fd);
+        if (fds[1] != -1)
+            close(fds[1]);
+        in_fd = fds[0];
+    }
+    info->status = waitStages(info, pids, stages, count);
+    free(stages);
+    return (info->status);
+}
+
+/**
+ * pipeStatusString - Formats $PIPESTATUS, the status of each pipeline stage.
+ * @info: The parameter struct holding the statuses.
+ *
+ * Description: After a simple command the list holds only its status.
+ *
+ * Return: Allocated space-separated list of statuses, or NULL on failure.
+ */
+char *pipeStatusString(shell_info *info)
+{
+    int i, count = info->pipecount ? info->pipecount : 1;
+    char *list = malloc(count * 12 + 1);
+
+    if (!list)
+        return (NULL);
+
+    list[0] = '\0';
+    for (i = 0; i < count; i++)
+    {
+        if (i)
+            _strcat(list, " ");
+        _strcat(list, convert_number(info->pipecount ?
+                    info->pipestatus[i] : info->status, 10, 0));
+    }
+    return (list);
+}
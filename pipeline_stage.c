@@ -0,0 +1,120 @@
+#include "shell.h"
+
+/**
+ * startStage - Starts one stage of a pipeline without waiting for it.
+ * @info: The parameter & return info struct.
+ * @av: The argument vector from main().
+ * @n: The node of the stage.
+ * @in_fd: Read end of the previous pipe, or -1 to keep stdin.
+ * @out_fd: Write end of the next pipe, or -1 to keep stdout.
+ *
+ * Description: Simple commands are launched directly; subshells and
+ * groups run in a forked copy of the shell.
+ *
+ * Return: The pid of the stage, or -1 if it could not be started.
+ */
+pid_t startStage(shell_info *info, char **av, int n, int in_fd, int out_fd)
+{
+    ast_node_t *node = info->ast + n;
+    pid_t pid;
+
+    if (node->type != AST_CMD)
+        return (forkNode(info, av, n, in_fd, out_fd));
+
+    setArgv(info, node->tok, node->ntok);
+    pid = launchStage(info, in_fd, out_fd);
+    freeArgv(info);
+    freeRedirections(info);
+    return (pid);
+}
+
+/**
+ * launchStage - Starts one stage of a pipeline without waiting for it.
+ * @info: The parameter struct; info->argv holds the expanded words of
+ *        the stage.
+ * @in_fd: Read end of the previous pipe, or -1 to keep stdin.
+ * @out_fd: Write end of the next pipe, or -1 to keep stdout.
+ *
+ * Description: External commands are spawned with the pipe ends and the
+ * stage's own redirections installed through posix_spawn file actions;
+ * builtins need a forked child.
+ * On failure info->status holds the status of the stage.
+ *
+ * Return: The pid of the stage, or -1 if it could not be started.
+ */
+pid_t launchStage(shell_info *info, int in_fd, int out_fd)
+{
+    posix_spawn_file_actions_t actions;
+    builtin_table *builtin;
+    char *path;
+    pid_t pid;
+
+    info->status = 0;
+    if (prepareRedirections(info) == -1 || !info->argc)
+        return (-1);
+    builtin = getBuiltin(info->argv[0]);
+    if (builtin)
+        return (forkBuiltinStage(info, builtin, in_fd, out_fd));
+    path = resolveCmd(info, info->argv[0]);
+    if (!path && isCmd(info, info->argv[0]))
+        path = info->argv[0];
+    if (!path)
+        return (info->status = 127, print_error(info, "not found\n"), -1);
+    posix_spawn_file_actions_init(&actions);
+    if (in_fd != -1)
+        posix_spawn_file_actions_adddup2(&actions, in_fd, STDIN_FILENO);
+    if (out_fd != -1)
+        posix_spawn_file_actions_adddup2(&actions, out_fd, STDOUT_FILENO);
+    addRedirActions(info, &actions);
+    pid = spawnProcess(info, path, info->argv, &actions);
+    posix_spawn_file_actions_destroy(&actions);
+    if (pid == -1)
+    {
+        info->status = errno == EACCES ? 126 : 127;
+        print_error(info, errno == EACCES ? "Permission denied\n" :
+                "not found\n");
+    }
+    return (pid);
+}
+
+/**
+ * forkBuiltinStage - Runs a builtin as a pipeline stage in a child.
+ * @info: The parameter struct; info->argv holds the words of the stage.
+ * @builtin: The builtin to run.
+ * @in_fd: Read end of the previous pipe, or -1 to keep stdin.
+ * @out_fd: Write end of the next pipe, or -1 to keep stdout.
+ *
+ * Return: The pid of the child, or -1 if fork() failed.
+ */
+pid_t forkBuiltinStage(shell_info *info, builtin_table *builtin,
+        int in_fd, int out_fd)
+{
+    pid_t pid;
+    int ret;
+
+    _putchar(BUF_FLUSH);
+    _buffered_err_putchar(BUF_FLUSH);
+    pid = fork();
+    if (pid == -1)
+    {
+        info->status = 1;
+        perror("Error:");
+        return (-1);
+    }
+    if (pid == 0)
+    {
+        if (in_fd != -1)
+            dup2(in_fd, STDIN_FILENO);
+        if (out_fd != -1)
+            dup2(out_fd, STDOUT_FILENO);
+        applyRedirections(info);
+        info->redirs = NULL;
+        ret = builtin->func(info);
+        if (ret == -2)
+            ret = info->err_num == -1 ? info->status : info->err_num;
+        _putchar(BUF_FLUSH);
+        _buffered_err_putchar(BUF_FLUSH);
+        _exit(ret);
+    }
+    return (pid);
+}
@@ -0,0 +1,197 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * inputReady - Checks whether a whole line can be read without blocking.
+ * @info: The parameter struct holding the input.
+ *
+ * Description: Only lines already in memory are read ahead: a read()
+ * could wait for a writer that is itself waiting for the running
+ * command, as a --serve client waits for its status record.
+ *
+ * Return: 1 if the next line is in the mapping or the input buffer.
+ */
+int inputReady(shell_info *info)
+{
+    input_buf_t *in = &info->input;
+
+    if (info->input_map)
+        return (info->input_pos < info->input_size);
+    return (in->pos < in->len &&
+            memchr(in->data + in->pos, '\n', in->len - in->pos) != NULL);
+}
+
+/**
+ * prefetchLine - Prepares the next command line while a child runs.
+ * @info: The parameter struct.
+ * @pidfd: pidfd of the child about to be waited for, or -1.
+ *
+ * Description: Called just before the shell blocks in wait. The next
+ * line is read, lexed, parsed and the command it starts with is looked
+ * up in PATH, so that all of it is done by the time the child exits.
+ * The time it took counts as hidden if the child was still running.
+ *
+ * Return: void
+ */
+void prefetchLine(shell_info *info, int pidfd)
+{
+    prefetch_t *pf = &info->prefetch;
+    struct pollfd done;
+    struct timespec start;
+    ssize_t got;
+    char *line = NULL;
+
+    if (pf->owner != getpid() || pf->line || info->script ||
+            interactive(info) || !inputReady(info))
+        return;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    got = info->input_map ? mapLine(info, &line, 0) :
+        custom_getline(info, &line, NULL);
+    if (got <= 0)
+        return;
+    if (parseAhead(info, line) == -1)
+    {
+        if (info->input_map && !line[got - 1])
+            line[got - 1] = '\n';
+        if (info->input_map)
+            info->input_pos -= got;
+        else
+            info->input.pos -= got, free(line);
+        return;
+    }
+    resolveAhead(info);
+    pf->gen = info->state_gen;
+    done.fd = pidfd;
+    done.events = POLLIN;
+    pf->pending = pidfd < 0 || poll(&done, 1, 0) == 0 ?
+        usecSince(&start) : 0;
+}
+
+/**
+ * parseAhead - Lexes and parses a line read ahead into info->prefetch.
+ * @info: The parameter struct; the tokens and tree of the line being run
+ *        are set aside meanwhile and put back.
+ * @line: The line, with or without its newline.
+ *
+ * Description: Only a line that parses on its own is kept. One that must
+ * be continued, has here-documents whose bodies come next in the input,
+ * or has a syntax error to report is left to be read again in turn.
+ *
+ * Return: 0 if the line was kept, -1 otherwise.
+ */
+int parseAhead(shell_info *info, char *line)
+{
+    prefetch_t *pf = &info->prefetch;
+    token_t *tokens = info->tokens;
+    ast_node_t *ast = info->ast;
+    char *arg = info->arg;
+    size_t arg_size = info->arg_size;
+    int ntokens = info->ntokens, root = info->root, n, ok;
+
+    info->tokens = NULL, info->ast = NULL;
+    if (*line && line[_strlen(line) - 1] == '\n')
+        line[_strlen(line) - 1] = '\0';
+    n = lexLine(info, line);
+    ok = n >= 0 && !hasHeredoc(info->tokens, n) &&
+        parseTokens(info, n, 1) == PARSE_OK;
+    pf->line = ok ? line : NULL;
+    pf->tokens = info->tokens, pf->ntokens = info->ntokens;
+    pf->ast = info->ast, pf->root = info->root;
+    if (!ok)
+        bfree((void **)&pf->tokens), bfree((void **)&pf->ast);
+
+    info->tokens = tokens, info->ntokens = ntokens;
+    info->ast = ast, info->root = root;
+    info->arg = arg, info->arg_size = arg_size;
+    return (ok ? 0 : -1);
+}
+
+/**
+ * resolveAhead - Looks up the first command of the line read ahead.
+ * @info: The parameter struct.
+ *
+ * Description: The path goes into the command hash table, where the
+ * lookup of the command will find it. Only a plain word is resolved:
+ * one needing expansion, a builtin, an alias or a path is not. The name
+ * is kept so the entry can be dropped if the running command changes
+ * the state it depends on, see takePrefetch().
+ *
+ * Return: void
+ */
+void resolveAhead(shell_info *info)
+{
+    prefetch_t *pf = &info->prefetch;
+    token_t *tok;
+    int n = pf->root, i;
+    char *name;
+    list_t *node;
+
+    while (n >= 0 && pf->ast[n].type != AST_CMD)
+        n = pf->ast[n].left;
+    if (n < 0)
+        return;
+    tok = pf->tokens + pf->ast[n].tok;
+    for (i = 0; i < pf->ast[n].ntok && tok[i].type == TOK_REDIR; i += 2)
+        ;
+    name = i < pf->ast[n].ntok ? malloc(tok[i].len + 1) : NULL;
+    if (!name)
+        return;
+    memcpy(name, tok[i].word, tok[i].len);
+    name[tok[i].len] = '\0';
+    if (strpbrk(name, "'\"\\$/") || getBuiltin(name) ||
+            hashFind(info, name) || nodeStartsWith(info->alias, name, '=') ||
+            !resolveCmd(info, name))
+    {
+        free(name);
+        return;
+    }
+    node = hashFind(info, name);
+    if (node)
+        node->num--;
+    pf->cmd = name;
+}
+
+/**
+ * takePrefetch - Makes the line read ahead the current line.
+ * @info: The parameter struct.
+ * @buf: Address of the current line, replaced by the one read ahead.
+ *
+ * Description: The tokens and tree stay valid whatever the running
+ * command did, but if it changed the directory, the environment or the
+ * aliases, the command resolved ahead is forgotten again.
+ *
+ * Return: Length of the line plus its newline, or -1 if none is waiting.
+ */
+ssize_t takePrefetch(shell_info *info, char **buf)
+{
+    prefetch_t *pf = &info->prefetch;
+    list_t **bucket;
+    list_t *node;
+
+    if (!pf->line)
+        return (-1);
+    if (pf->gen != info->state_gen)
+    {
+        node = pf->cmd ? hashFind(info, pf->cmd) : NULL;
+        bucket = node ? &info->cmd_hash[hashName(pf->cmd)] : NULL;
+        if (node)
+            remove_node_at(bucket, get_node_index(*bucket, node));
+        pf->discarded++;
+    }
+    else
+        pf->hidden += pf->pending, pf->lines++;
+    bfree((void **)&pf->cmd);
+
+    freeLine(info, *buf);
+    free(info->tokens);
+    free(info->ast);
+    *buf = pf->line;
+    info->tokens = pf->tokens, info->ntokens = pf->ntokens;
+    info->ast = pf->ast, info->root = pf->root;
+    info->arg = pf->line, info->arg_size = _strlen(pf->line) + 1;
+    pf->line = NULL, pf->tokens = NULL, pf->ast = NULL;
+    info->line_count++;
+    append_to_history(info, *buf);
+    finishTokens(info);
+    return (info->arg_size);
+}
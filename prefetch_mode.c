@@ -0,0 +1,52 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * startPrefetch - Turns on reading ahead when HSH_PIPELINE is set.
+ * @info: The parameter struct.
+ *
+ * Description: Only this process reads ahead; children that wait for
+ * their own children inherit the setting but not the ownership.
+ *
+ * Return: void
+ */
+void startPrefetch(shell_info *info)
+{
+    char *on = getenv(PIPELINE_VAR);
+
+    if (on && *on && _strcmp(on, "0"))
+        info->prefetch.owner = getpid();
+}
+
+/**
+ * endPrefetch - Reports what reading ahead saved and frees what is left.
+ * @info: The parameter struct.
+ *
+ * Description: The report goes to stderr: lines that were ready when
+ * their turn came, the front-end time hidden behind running commands,
+ * and lines whose command lookup had to be dropped.
+ *
+ * Return: void
+ */
+void endPrefetch(shell_info *info)
+{
+    prefetch_t *pf = &info->prefetch;
+
+    if (pf->owner != getpid())
+        return;
+    freeLine(info, pf->line);
+    bfree((void **)&pf->tokens);
+    bfree((void **)&pf->ast);
+    bfree((void **)&pf->cmd);
+    pf->line = NULL;
+
+    _eputs(info->fname);
+    _eputs(": read ahead ");
+    _eputs(convert_number(pf->lines + pf->discarded, 10, 0));
+    _eputs(" lines, hid ");
+    _eputs(convert_fixed(pf->hidden, 1000));
+    _eputs(" ms of front-end work, ");
+    _eputs(convert_number(pf->discarded, 10, 0));
+    _eputs(" lookups discarded\n");
+    _buffered_err_putchar(BUF_FLUSH);
+}
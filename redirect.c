@@ -0,0 +1,128 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * parseRedirection - Appends a redirection of the command to info->redirs.
+ * @info: The parameter struct.
+ * @op: The TOK_REDIR token, e.g. "<", ">>", "2>", "2>&" or "<<".
+ * @target: The expanded word after it, freed here: a file, the M of
+ *          "N>&M", the "-" of "N>&-" or the text of a here-string.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int parseRedirection(shell_info *info, token_t *op, char *target)
+{
+    redir_t *redir = malloc(sizeof(redir_t)), **tail;
+    char *c = op->word;
+
+    if (!redir || !target)
+        return (free(redir), freeArg(info, target), -1);
+    redir->fd = op->fd;
+    if (redir->fd < 0)
+        redir->fd = *c == '<' ? STDIN_FILENO : STDOUT_FILENO;
+    redir->flags = *c == '<' ? O_RDONLY : O_WRONLY | O_CREAT | O_TRUNC;
+    if (!_strcmp(c, ">>"))
+        redir->flags = O_WRONLY | O_CREAT | O_APPEND;
+    else if (!_strcmp(c, "<>"))
+        redir->flags = O_RDWR | O_CREAT;
+    redir->flags |= O_CLOEXEC;
+    redir->file = NULL;
+    redir->src_fd = redir->saved_fd = -1;
+    redir->owned = 0;
+    redir->next = NULL;
+    if (c[1] == '<')
+        parseHereRedir(info, redir, op, target);
+    else if (c[1] == '&' && !_strcmp(target, "-"))
+        redir->src_fd = REDIR_CLOSE;
+    else if (c[1] == '&' && *target && _erratoi(target) >= 0)
+        redir->src_fd = _erratoi(target);
+    else
+        redir->file = _strdup(target);
+    freeArg(info, target);
+
+    for (tail = &(info->redirs); *tail; tail = &((*tail)->next))
+        ;
+    *tail = redir;
+    return (0);
+}
+
+/**
+ * openRedirections - Opens the files named by the redirections.
+ * @info: The parameter struct.
+ *
+ * Description: Files are opened in the shell, close-on-exec, so errors
+ * are reported before anything runs; the child only has to dup2().
+ *
+ * Return: NULL on success, or the redirection that failed.
+ */
+redir_t *openRedirections(shell_info *info)
+{
+    redir_t *redir;
+
+    for (redir = info->redirs; redir; redir = redir->next)
+    {
+        if (redir->file)
+            redir->src_fd = open(redir->file, redir->flags, 0666);
+        if (redir->src_fd == REDIR_CLOSE)
+            continue;
+        if (redir->src_fd < 0 || fcntl(redir->src_fd, F_GETFD) == -1)
+            return (redir);
+    }
+    return (NULL);
+}
+
+/**
+ * prepareRedirections - Opens the redirections of a command.
+ * @info: The parameter & return info struct.
+ *
+ * Description: A file that cannot be opened is reported with the reason
+ * open() gave, worded as dash does for a missing file.
+ *
+ * Return: 0 if the command can run, -1 after reporting an error
+ *         (info->status is set to 2).
+ */
+int prepareRedirections(shell_info *info)
+{
+    redir_t *bad = openRedirections(info);
+    int err = errno;
+
+    if (!bad)
+        return (0);
+
+    info->status = 2;
+    _eputs(info->fname);
+    _eputs(": ");
+    print_d(info->line_count, STDERR_FILENO);
+    if (!bad->file)
+        _eputs(": Bad fd number\n");
+    else
+    {
+        _eputs(bad->flags & O_CREAT ? ": cannot create " : ": cannot open ");
+        _eputs(bad->file);
+        _eputs(": ");
+        _eputs(err == ENOENT ? "No such file" : strerror(err));
+        _eputs("\n");
+    }
+    return (-1);
+}
+
+/**
+ * freeRedirections - Closes opened files and frees the redirections.
+ * @info: The parameter struct.
+ *
+ * Return: void
+ */
+void freeRedirections(shell_info *info)
+{
+    redir_t *redir;
+
+    while (info->redirs)
+    {
+        redir = info->redirs;
+        info->redirs = redir->next;
+        if ((redir->file || redir->owned) && redir->src_fd >= 0)
+            close(redir->src_fd);
+        free(redir->file);
+        free(redir);
+    }
+}
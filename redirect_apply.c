@@ -0,0 +1,111 @@
+#include "shell.h"
+
+/**
+ * addRedirActions - Queues the redirections as posix_spawn file actions.
+ * @info: The parameter struct holding the opened redirections.
+ * @actions: The file actions of the child being spawned.
+ *
+ * Return: void
+ */
+void addRedirActions(shell_info *info, posix_spawn_file_actions_t *actions)
+{
+    redir_t *redir;
+
+    for (redir = info->redirs; redir; redir = redir->next)
+        if (redir->src_fd == REDIR_CLOSE)
+            posix_spawn_file_actions_addclose(actions, redir->fd);
+        else
+            posix_spawn_file_actions_adddup2(actions, redir->src_fd,
+                    redir->fd);
+}
+
+/**
+ * applyRedirections - Installs the redirections in the current process.
+ * @info: The parameter struct holding the opened redirections.
+ *
+ * Description: Used in forked children; descriptors opened for files are
+ * close-on-exec, only their dup2() copies survive execve().
+ *
+ * Return: void
+ */
+void applyRedirections(shell_info *info)
+{
+    redir_t *redir;
+
+    for (redir = info->redirs; redir; redir = redir->next)
+        if (redir->src_fd == REDIR_CLOSE)
+            close(redir->fd);
+        else
+            dup2(redir->src_fd, redir->fd);
+}
+
+/**
+ * restoreRedirections - Puts back the descriptors saved for a builtin.
+ * @redir: The first redirection; the list is undone from its end so a
+ *         descriptor redirected twice gets its original back.
+ *
+ * Return: void
+ */
+void restoreRedirections(redir_t *redir)
+{
+    if (!redir)
+        return;
+
+    restoreRedirections(redir->next);
+    if (redir->saved_fd >= 0)
+    {
+        dup2(redir->saved_fd, redir->fd);
+        close(redir->saved_fd);
+    }
+    else
+        close(redir->fd);
+    redir->saved_fd = -1;
+}
+
+/**
+ * redirectShell - Installs redirections on the shell's own descriptors.
+ * @redirs: The opened redirections; each one saves the descriptor it
+ *          replaces, for restoreRedirections().
+ *
+ * Return: void
+ */
+void redirectShell(redir_t *redirs)
+{
+    _putchar(BUF_FLUSH);
+    _buffered_err_putchar(BUF_FLUSH);
+    for (; redirs; redirs = redirs->next)
+    {
+        redirs->saved_fd = fcntl(redirs->fd, F_DUPFD_CLOEXEC, 10);
+        if (redirs->src_fd == REDIR_CLOSE)
+            close(redirs->fd);
+        else
+            dup2(redirs->src_fd, redirs->fd);
+    }
+}
+
+/**
+ * runRedirectedBuiltin - Runs a builtin with its output redirected.
+ * @info: The parameter struct holding the opened redirections.
+ * @builtin: The builtin to run.
+ *
+ * Description: The shell's own descriptors are redirected while the
+ * builtin runs and restored afterwards; commands the builtin starts
+ * (command, timeout, parallel) inherit them.
+ *
+ * Return: The return value of the builtin.
+ */
+int runRedirectedBuiltin(shell_info *info, builtin_table *builtin)
+{
+    redir_t *redirs = info->redirs;
+    int ret;
+
+    redirectShell(redirs);
+    info->redirs = NULL;
+    ret = builtin->func(info);
+    info->redirs = redirs;
+
+    _putchar(BUF_FLUSH);
+    _buffered_err_putchar(BUF_FLUSH);
+    restoreRedirections(redirs);
+    return (ret);
+}
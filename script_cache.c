@@ -0,0 +1,178 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <sys/mman.h>
+
+/**
+ * hashBytes - Continues an FNV-1a hash over a block of memory.
+ * @hash: The hash so far; start with HASH_SEED.
+ * @data: The block.
+ * @len: Its size.
+ *
+ * Return: The updated hash.
+ */
+unsigned long hashBytes(unsigned long hash, const void *data, size_t len)
+{
+    const unsigned char *c = data;
+
+    while (len--)
+    {
+        hash ^= *c++;
+        hash *= 1099511628211UL;
+    }
+    return (hash);
+}
+
+/**
+ * scriptCachePath - Chooses where the compiled form of a script lives.
+ * @info: The parameter struct holding the environment.
+ * @real: The absolute path of the script.
+ *
+ * Description: The file is named after a hash of the script's path, in
+ * the private "hsh" directory of SCRIPT_CACHE_VAR, or of ~/.cache when
+ * it is not set, see cacheDir(). It is never put next to the script,
+ * where others may be able to write.
+ *
+ * Return: The allocated path, or NULL if there is no cache directory
+ *         the shell can trust.
+ */
+char *scriptCachePath(shell_info *info, char *real)
+{
+    char *base = getEnvironment(info, SCRIPT_CACHE_VAR), *home, *dir;
+    char *path = NULL;
+    unsigned long hash = hashBytes(HASH_SEED, real, _strlen(real));
+
+    home = getEnvironment(info, "HOME=");
+    if (base && *base == '/')
+        dir = cacheDir(base);
+    else if (home && *home == '/')
+    {
+        base = malloc(_strlen(home) + 8);
+        if (!base)
+            return (NULL);
+        _strcpy(base, home);
+        _strcat(base, "/.cache");
+        dir = cacheDir(base);
+        free(base);
+    }
+    else
+        return (NULL);
+
+    path = dir ? malloc(_strlen(dir) + 32) : NULL;
+    if (path)
+    {
+        _strcpy(path, dir);
+        _strcat(path, "/");
+        _strcat(path, convert_number(hash, 16,
+                    CONVERT_UNSIGNED | CONVERT_LOWERCASE));
+        _strcat(path, ".hshc");
+    }
+    free(dir);
+    return (path);
+}
+
+/**
+ * scriptTables - Finds the tables of a compiled script.
+ * @head: The header at the start of the compiled script.
+ * @lines: Set to the lines.
+ * @tokens: Set to the tokens.
+ * @nodes: Set to the nodes.
+ *
+ * Return: The strings, which end the compiled script.
+ */
+char *scriptTables(script_header_t *head, script_line_t **lines,
+        script_token_t **tokens, ast_node_t **nodes)
+{
+    *lines = (script_line_t *)(head + 1);
+    *tokens = (script_token_t *)(*lines + head->nlines);
+    *nodes = (ast_node_t *)(*tokens + head->ntokens);
+    return ((char *)(*nodes + head->nnodes));
+}
+
+/**
+ * scriptValid - Checks a compiled script against the script.
+ * @head: The mapped compiled script.
+ * @size: Size of the mapping.
+ * @real: The absolute path of the script.
+ * @st: The status of the script.
+ * @source: Hash of the text of the script.
+ *
+ * Description: The tables must fill the file exactly and the script must
+ * still have the path, size, modification time and text it was compiled
+ * from. The hash guards against a truncated or damaged file, and every
+ * index and offset is checked, see tablesValid().
+ *
+ * Return: 1 if the compiled script can be run, 0 otherwise.
+ */
+int scriptValid(script_header_t *head, size_t size, char *real,
+        struct stat *st, unsigned long source)
+{
+    script_line_t *lines;
+    script_token_t *tokens;
+    ast_node_t *nodes;
+    char *strings;
+
+    if (size < sizeof(*head) || memcmp(head->magic, SCRIPT_MAGIC, 4) ||
+            head->version != SCRIPT_VERSION || head->size != st->st_size ||
+            head->mtime != st->st_mtim.tv_sec ||
+            head->mtime_nsec != st->st_mtim.tv_nsec ||
+            head->source != source || head->nlines < 0 ||
+            head->ntokens < 0 || head->nnodes < 0)
+        return (0);
+    if (size != sizeof(*head) + head->nlines * sizeof(*lines) +
+            head->ntokens * sizeof(*tokens) +
+            head->nnodes * sizeof(*nodes) + head->strsize)
+        return (0);
+    strings = scriptTables(head, &lines, &tokens, &nodes);
+    if (head->path < 0 || (size_t)head->path >= head->strsize ||
+            strings[head->strsize - 1] != '\0')
+        return (0);
+    return (!_strcmp(strings + head->path, real) &&
+            hashBytes(HASH_SEED, head + 1,
+                size - sizeof(*head)) == head->hash && tablesValid(head));
+}
+
+/**
+ * mapScriptCache - Maps a compiled script to run it.
+ * @info: The parameter struct; info->script is set on success.
+ * @cache: Path of the compiled script.
+ * @real: The absolute path of the script.
+ * @st: The status of the script.
+ * @source: Hash of the text of the script.
+ *
+ * Description: The whole file is mapped read-only at once; the lines are
+ * run straight from the mapping, see scriptLine(). A file others could
+ * have written is not used: it must be owned by the user and not
+ * writable by group or others.
+ *
+ * Return: 0 on success, -1 if there is no valid compiled script.
+ */
+int mapScriptCache(shell_info *info, char *cache, char *real,
+        struct stat *st, unsigned long source)
+{
+    struct stat cst;
+    void *map;
+    int fd = open(cache, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+
+    if (fd == -1)
+        return (-1);
+    if (fstat(fd, &cst) == -1 || !S_ISREG(cst.st_mode) ||
+            cst.st_uid != geteuid() || (cst.st_mode & (S_IWGRP | S_IWOTH)) ||
+            cst.st_size < (off_t)sizeof(*info->script))
+    {
+        close(fd);
+        return (-1);
+    }
+    map = mmap(NULL, cst.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return (-1);
+    if (!scriptValid(map, cst.st_size, real, st, source))
+    {
+        munmap(map, cst.st_size);
+        return (-1);
+    }
+    info->script = map;
+    info->script_size = cst.st_size;
+    info->script_line = 0;
+    return (0);
+}
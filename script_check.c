@@ -0,0 +1,149 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * cacheDir - Gives the private directory compiled scripts are kept in.
+ * @base: The cache directory of the user, such as ~/.cache.
+ *
+ * Description: The "hsh" directory in it is created with mode 0700 if
+ * needed. It is refused if it is not a directory of its own owned by
+ * the user with no access for group or others, since anyone able to
+ * write in it could have the shell run any compiled script.
+ *
+ * Return: The allocated path of the directory, or NULL if it cannot be
+ *         used.
+ */
+char *cacheDir(char *base)
+{
+    struct stat st;
+    char *dir = malloc(_strlen(base) + 8);
+
+    if (!dir)
+        return (NULL);
+    _strcpy(dir, base);
+    mkdir(dir, 0700);
+    _strcat(dir, "/hsh");
+    mkdir(dir, 0700);
+    if (lstat(dir, &st) == -1 || !S_ISDIR(st.st_mode) ||
+            st.st_uid != geteuid() || (st.st_mode & 077))
+    {
+        free(dir);
+        return (NULL);
+    }
+    return (dir);
+}
+
+/**
+ * wordsValid - Checks the tokens a command is run with.
+ * @tok: The tokens of the line.
+ * @from: Index of the first one.
+ * @to: Index after the last one.
+ *
+ * Return: 1 if they are words and redirections each followed by its
+ *         target word, 0 otherwise.
+ */
+int wordsValid(script_token_t *tok, int from, int to)
+{
+    for (; from < to; from++)
+    {
+        if (tok[from].type == TOK_REDIR && (++from == to ||
+                    tok[from].type != TOK_WORD))
+            return (0);
+        if (tok[from].type != TOK_WORD && tok[from].type != TOK_REDIR)
+            return (0);
+    }
+    return (1);
+}
+
+/**
+ * nodeValid - Checks a node of a compiled line.
+ * @node: The node.
+ * @n: Its index in the line; children come before their parent.
+ * @tok: The tokens of the line.
+ * @ntok: Their number.
+ *
+ * Description: A child must be an earlier node, so the tree has no
+ * cycle, and the tokens a node covers must be the line's.
+ *
+ * Return: 1 if the node can be run, 0 otherwise.
+ */
+int nodeValid(ast_node_t *node, int n, script_token_t *tok, int ntok)
+{
+    int t = node->type, end;
+
+    if (t < AST_CMD || t > AST_GROUP || node->tok < 0 || node->ntok < 0 ||
+            node->ntok > ntok || node->tok > ntok - node->ntok)
+        return (0);
+    end = node->tok + node->ntok;
+    if (t == AST_CMD)
+        return (wordsValid(tok, node->tok, end));
+    if (node->left < (t == AST_TIME ? -1 : 0) || node->left >= n)
+        return (0);
+    if (t == AST_SUBSHELL || t == AST_GROUP)
+        return (node->right >= node->tok && node->right <= end &&
+                wordsValid(tok, node->right, end));
+    if (t == AST_PIPE || t == AST_AND || t == AST_OR || t == AST_SEQ)
+        return (node->right >= 0 && node->right < n);
+    return (1);
+}
+
+/**
+ * lineValid - Checks a line of a compiled script and what it refers to.
+ * @head: The mapped compiled script, whose sizes are already checked.
+ * @line: The line.
+ *
+ * Return: 1 if the line can be run, 0 otherwise.
+ */
+int lineValid(script_header_t *head, script_line_t *line)
+{
+    script_line_t *lines;
+    script_token_t *tok;
+    ast_node_t *nodes;
+    int i;
+
+    scriptTables(head, &lines, &tok, &nodes);
+    if (line->text < 0 || (size_t)line->text >= head->strsize ||
+            line->tok < 0 || line->ntok < 0 || line->ntok > head->ntokens ||
+            line->tok > head->ntokens - line->ntok ||
+            line->node < 0 || line->root < -1 ||
+            line->root >= head->nnodes ||
+            line->node > head->nnodes - line->root - 1)
+        return (0);
+    tok += line->tok;
+    for (i = 0; i < line->ntok; i++)
+        if (tok[i].type < TOK_WORD || tok[i].type > TOK_REDIR ||
+                tok[i].len < 0 || tok[i].word < -1 ||
+                (tok[i].word == -1 && (tok[i].type == TOK_WORD ||
+                                       tok[i].type == TOK_REDIR)) ||
+                (tok[i].word >= 0 && (size_t)tok[i].word + tok[i].len >=
+                 head->strsize))
+            return (0);
+    for (i = 0; i <= line->root; i++)
+        if (!nodeValid(nodes + line->node + i, i, tok, line->ntok))
+            return (0);
+    return (1);
+}
+
+/**
+ * tablesValid - Checks every offset and index of a compiled script.
+ * @head: The mapped compiled script, whose sizes are already checked.
+ *
+ * Description: A compiled script is only ever run from these indices,
+ * so one that passes cannot make the shell read outside the mapping,
+ * whoever wrote it.
+ *
+ * Return: 1 if the compiled script can be run, 0 otherwise.
+ */
+int tablesValid(script_header_t *head)
+{
+    script_line_t *lines;
+    script_token_t *tokens;
+    ast_node_t *nodes;
+    int i;
+
+    scriptTables(head, &lines, &tokens, &nodes);
+    for (i = 0; i < head->nlines; i++)
+        if (!lineValid(head, lines + i))
+            return (0);
+    return (1);
+}
@@ -0,0 +1,204 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <sys/uio.h>
+
+/**
+ * growArray - Makes room in one of the tables of a script being compiled.
+ * @array: Address of the table.
+ * @cap: Address of its allocated size, in elements.
+ * @need: Number of elements it must hold.
+ * @size: Size of an element.
+ *
+ * Return: 0 on success, -1 on allocation failure.
+ */
+int growArray(void **array, size_t *cap, size_t need, size_t size)
+{
+    size_t grown = *cap ? *cap : 64;
+    void *p;
+
+    if (need <= *cap)
+        return (0);
+    while (grown < need)
+        grown *= 2;
+    p = realloc(*array, grown * size);
+    if (!p)
+        return (-1);
+    *array = p;
+    *cap = grown;
+    return (0);
+}
+
+/**
+ * addString - Adds a NUL-terminated copy of a string to the strings.
+ * @b: The script being compiled.
+ * @s: The string, not necessarily NUL-terminated.
+ * @len: Its length.
+ *
+ * Return: Offset of the copy, or -1 on allocation failure.
+ */
+int addString(script_build_t *b, char *s, size_t len)
+{
+    int offset = b->head.strsize;
+
+    if (growArray((void **)&b->strings, &b->caps[3],
+                b->head.strsize + len + 1, 1) == -1)
+        return (-1);
+    memcpy(b->strings + offset, s, len);
+    b->strings[offset + len] = '\0';
+    b->head.strsize += len + 1;
+    return (offset);
+}
+
+/**
+ * addLine - Adds a parsed command line to a script being compiled.
+ * @b: The script being compiled.
+ * @info: The parameter struct holding the line's tokens and tree.
+ * @text: The line as written.
+ *
+ * Description: Nodes are created children first, so the root is the
+ * last node of the line. Here-documents read their bodies from the input
+ * while the script runs, so a script using them is not compiled.
+ *
+ * Return: 0 on success, -1 if the line cannot be compiled.
+ */
+int addLine(script_build_t *b, shell_info *info, char *text)
+{
+    script_line_t *line;
+    script_token_t *tok;
+    token_t *t = info->tokens;
+    int i, nnodes = info->root + 1;
+
+    if (hasHeredoc(t, info->ntokens) ||
+            growArray((void **)&b->lines, &b->caps[0], b->head.nlines + 1,
+                sizeof(*line)) == -1 ||
+            growArray((void **)&b->tokens, &b->caps[1],
+                b->head.ntokens + info->ntokens, sizeof(*tok)) == -1 ||
+            growArray((void **)&b->nodes, &b->caps[2],
+                b->head.nnodes + nnodes, sizeof(ast_node_t)) == -1)
+        return (-1);
+    line = b->lines + b->head.nlines++;
+    line->text = addString(b, text, _strlen(text));
+    line->tok = b->head.ntokens;
+    line->ntok = info->ntokens;
+    line->node = b->head.nnodes;
+    line->root = info->root;
+    if (nnodes)
+        memcpy(b->nodes + b->head.nnodes, info->ast,
+                sizeof(ast_node_t) * nnodes);
+    b->head.nnodes += nnodes;
+
+    for (i = 0; i < info->ntokens; i++)
+    {
+        tok = b->tokens + b->head.ntokens++;
+        tok->type = t[i].type;
+        tok->fd = t[i].fd;
+        tok->len = t[i].len;
+        tok->word = !t[i].word ? -1 : addString(b, t[i].word,
+                t[i].type == TOK_WORD ? t[i].len : _strlen(t[i].word));
+        if (t[i].word && tok->word == -1)
+            return (-1);
+    }
+    return (line->text == -1 ? -1 : 0);
+}
+
+/**
+ * compileScript - Lexes and parses a whole script ahead of running it.
+ * @info: The parameter struct, used for lexing and parsing.
+ * @text: The script, with one spare byte after it.
+ * @size: The size of the script.
+ * @b: Filled in with the compiled script; free its tables in any case.
+ *
+ * Description: Lines are split like custom_getline() splits them, and a
+ * line that is incomplete is joined with the next one, as
+ * continueLine() would. Syntax errors are left to the normal reader,
+ * which reports them when the line is reached.
+ *
+ * Return: 0 on success, -1 if the script cannot be compiled.
+ */
+int compileScript(shell_info *info, char *text, size_t size,
+        script_build_t *b)
+{
+    char *line = text, *end = text, *stop = text + size;
+    int n, parsed;
+
+    _memset((char *)b, 0, sizeof(*b));
+    while (line < stop)
+    {
+        end = memchr(end, '\n', stop - end);
+        if (!end)
+            end = stop;
+        *end = '\0';
+        n = lexLine(info, line);
+        parsed = n < 0 ? n == -2 ? PARSE_INCOMPLETE : PARSE_SYNTAX :
+            parseTokens(info, n, 1);
+        if (parsed == PARSE_INCOMPLETE && end < stop)
+        {
+            *end++ = '\n';
+            continue;
+        }
+        if (parsed != PARSE_OK || addLine(b, info, line) == -1)
+            return (-1);
+        line = end = end + 1;
+    }
+    return (0);
+}
+
+/**
+ * writeScriptCache - Saves a compiled script.
+ * @b: The compiled script.
+ * @cache: Where to save it.
+ * @real: The absolute path of the script.
+ * @st: The status of the script.
+ *
+ * Description: The file is written under a temporary name and renamed
+ * over the old one, so a shell running the script at the same time
+ * never maps a half-written file.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int writeScriptCache(script_build_t *b, char *cache, char *real,
+        struct stat *st)
+{
+    struct iovec iov[5];
+    char *tmp = malloc(_strlen(cache) + 24);
+    ssize_t total = 0;
+    int fd, i;
+
+    b->head.path = addString(b, real, _strlen(real));
+    if (!tmp || b->head.path == -1)
+        return (free(tmp), -1);
+    memcpy(b->head.magic, SCRIPT_MAGIC, 4);
+    b->head.version = SCRIPT_VERSION;
+    b->head.size = st->st_size;
+    b->head.mtime = st->st_mtim.tv_sec;
+    b->head.mtime_nsec = st->st_mtim.tv_nsec;
+    iov[1].iov_base = b->lines;
+    iov[1].iov_len = b->head.nlines * sizeof(*b->lines);
+    iov[2].iov_base = b->tokens;
+    iov[2].iov_len = b->head.ntokens * sizeof(*b->tokens);
+    iov[3].iov_base = b->nodes;
+    iov[3].iov_len = b->head.nnodes * sizeof(*b->nodes);
+    iov[4].iov_base = b->strings;
+    iov[4].iov_len = b->head.strsize;
+    b->head.hash = HASH_SEED;
+    for (i = 1; i < 5; total += iov[i++].iov_len)
+        b->head.hash = hashBytes(b->head.hash, iov[i].iov_base,
+                iov[i].iov_len);
+    iov[0].iov_base = &b->head;
+    iov[0].iov_len = sizeof(b->head);
+    total += sizeof(b->head);
+
+    _strcpy(tmp, cache);
+    _strcat(tmp, ".");
+    _strcat(tmp, convert_number(getpid(), 10, 0));
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd == -1)
+        return (free(tmp), -1);
+    i = writev(fd, iov, 5) == total;
+    if (close(fd) == -1 || !i || rename(tmp, cache) == -1)
+    {
+        unlink(tmp);
+        return (free(tmp), -1);
+    }
+    return (free(tmp), 0);
+}
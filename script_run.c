@@ -0,0 +1,146 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <sys/mman.h>
+
+/**
+ * readScript - Reads a whole script into memory to compile it.
+ * @fd: The script, positioned at its start; it is rewound afterwards.
+ * @size: Its size.
+ *
+ * Return: The allocated text, with one spare byte, or NULL on failure.
+ */
+char *readScript(int fd, size_t size)
+{
+    char *text = malloc(size + 1);
+    size_t done = 0;
+    ssize_t got = 1;
+
+    while (text && done < size && got > 0)
+    {
+        got = read(fd, text + done, size - done);
+        done += got > 0 ? got : 0;
+    }
+    lseek(fd, 0, SEEK_SET);
+    if (text && done < size)
+    {
+        free(text);
+        return (NULL);
+    }
+    return (text);
+}
+
+/**
+ * loadScript - Runs a script from its compiled form, compiling it first
+ *              if needed.
+ * @info: The parameter struct; info->readfd is the open script.
+ * @path: The script as named on the command line.
+ *
+ * Description: A compiled script that still matches the script, text
+ * included, is mapped and its lines run without lexing or parsing them
+ * again. Otherwise the script is compiled, saved (see scriptCachePath())
+ * and mapped. When it cannot be, the script is read line by line as
+ * before.
+ *
+ * Return: 0 if the compiled script is used, -1 otherwise.
+ */
+int loadScript(shell_info *info, char *path)
+{
+    char real[PATH_MAX], *cache, *text = NULL;
+    struct stat st;
+    script_build_t b;
+    unsigned long source;
+    int ret = -1;
+
+    if (!realpath(path, real) || fstat(info->readfd, &st) == -1 ||
+            !S_ISREG(st.st_mode))
+        return (-1);
+    cache = scriptCachePath(info, real);
+    text = cache ? readScript(info->readfd, st.st_size) : NULL;
+    source = text ? hashBytes(HASH_SEED, text, st.st_size) : 0;
+    if (text && mapScriptCache(info, cache, real, &st, source) == 0)
+        ret = 0;
+    else if (text)
+    {
+        if (compileScript(info, text, st.st_size, &b) == 0)
+        {
+            b.head.source = source;
+            if (writeScriptCache(&b, cache, real, &st) == 0)
+                ret = mapScriptCache(info, cache, real, &st, source);
+        }
+        free(b.lines);
+        free(b.tokens);
+        free(b.nodes);
+        free(b.strings);
+    }
+    free(text);
+    free(cache);
+    info->arg = NULL;
+    info->arg_size = 0;
+    return (ret);
+}
+
+/**
+ * scriptLine - Takes the next command line of the compiled script.
+ * @info: The parameter struct; the tokens and tree of the line are set
+ *        up as parseLine() and finishTokens() would.
+ *
+ * Description: Words point into the mapped strings, which info->arg
+ * covers so they are never freed. Only the token and node arrays are
+ * copied, the tokens to turn offsets back into pointers.
+ *
+ * Return: Length of the line, or -1 at the end of the script.
+ */
+ssize_t scriptLine(shell_info *info)
+{
+    script_line_t *line;
+    script_token_t *tok;
+    ast_node_t *nodes;
+    char *strings;
+    int i;
+
+    if (info->script_line >= info->script->nlines)
+        return (-1);
+    strings = scriptTables(info->script, &line, &tok, &nodes);
+    line += info->script_line++;
+    free(info->tokens);
+    free(info->ast);
+    info->tokens = malloc(sizeof(token_t) * (line->ntok + 1));
+    info->ast = malloc(sizeof(ast_node_t) * (line->root + 2));
+    if (!info->tokens || !info->ast)
+        return (-1);
+
+    tok += line->tok;
+    for (i = 0; i < line->ntok; i++)
+    {
+        info->tokens[i].type = tok[i].type;
+        info->tokens[i].fd = tok[i].fd;
+        info->tokens[i].len = tok[i].len;
+        info->tokens[i].word = tok[i].word < 0 ? NULL : strings + tok[i].word;
+    }
+    memcpy(info->ast, nodes + line->node, sizeof(ast_node_t) *
+            (line->root + 1));
+    info->ntokens = line->ntok;
+    info->root = line->root;
+    info->arg = strings;
+    info->arg_size = info->script->strsize;
+    for (i = line->text; strings[i]; i++)
+        info->line_count += strings[i] == '\n';
+    info->line_count++;
+    append_to_history(info, strings + line->text);
+    return (_strlen(strings + line->text));
+}
+
+/**
+ * unloadScript - Unmaps the compiled script.
+ * @info: The parameter struct.
+ *
+ * Return: void
+ */
+void unloadScript(shell_info *info)
+{
+    if (!info->script)
+        return;
+    munmap(info->script, info->script_size);
+    info->script = NULL;
+    info->script_size = 0;
+}
@@ -0,0 +1,180 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * serveListen - Creates the listening unix socket of the server mode.
+ * @path: Where to bind the socket; a stale socket there is replaced.
+ *
+ * Description: The socket is created with mode 0600, so only the user
+ * running the server can connect. Anything at path other than a socket
+ * is left alone and the server refuses to start.
+ *
+ * Return: The listening socket, or -1 on failure.
+ */
+int serveListen(char *path)
+{
+    struct sockaddr_un addr;
+    struct stat st;
+    mode_t mask;
+    int sock, ret;
+
+    if (_strlen(path) >= (int)sizeof(addr.sun_path))
+        return (errno = ENAMETOOLONG, -1);
+    if (lstat(path, &st) == 0 && !S_ISSOCK(st.st_mode))
+        return (errno = EEXIST, -1);
+    sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock == -1)
+        return (-1);
+
+    _memset((char *)&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    _strcpy(addr.sun_path, path);
+    unlink(path);
+    mask = umask(077);
+    ret = bind(sock, (struct sockaddr *)&addr, sizeof(addr));
+    umask(mask);
+    if (ret == -1 || listen(sock, SOMAXCONN) == -1)
+    {
+        close(sock);
+        return (-1);
+    }
+    return (sock);
+}
+
+/**
+ * serveShell - Runs the shell as a server on a unix socket ("--serve").
+ * @info: The warm parameter struct: env list, aliases and history loaded.
+ * @av: The argument vector from main().
+ * @path: The socket path.
+ *
+ * Description: Start-up work is paid once; every client gets a fork of
+ * the warm shell, so its cd, setenv and alias changes stay private to
+ * it. Finished clients are reaped by the kernel (SA_NOCLDWAIT).
+ *
+ * Return: Only returns on failure, with EXIT_FAILURE.
+ */
+int serveShell(shell_info *info, char **av, char *path)
+{
+    struct sigaction sa;
+    int sock = serveListen(path), client;
+
+    if (sock == -1)
+    {
+        _eputs(av[0]);
+        _eputs(": cannot listen on ");
+        _eputs(path);
+        _eputs(": ");
+        _eputs(strerror(errno));
+        _buffered_err_putchar('\n');
+        _buffered_err_putchar(BUF_FLUSH);
+        return (EXIT_FAILURE);
+    }
+    _memset((char *)&sa, 0, sizeof(sa));
+    sa.sa_handler = SIG_DFL;
+    sa.sa_flags = SA_NOCLDWAIT;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGCHLD, &sa, NULL);
+
+    while ((client = acceptClient(sock)) != -1)
+    {
+        if (fork() == 0)
+        {
+            close(sock);
+            serveClient(info, av, client);
+        }
+        close(client);
+    }
+    perror(av[0]);
+    close(sock);
+    return (EXIT_FAILURE);
+}
+
+/**
+ * acceptClient - Waits for the next client of the server.
+ * @sock: The listening socket.
+ *
+ * Description: A client that gave up before being accepted, or a signal,
+ * only means trying again. When the process or the system is out of file
+ * descriptors or memory, the server waits a moment before trying again,
+ * so as not to spin until some are released.
+ *
+ * Return: The connected socket, or -1 on any other error.
+ */
+int acceptClient(int sock)
+{
+    struct timespec pause;
+    int client;
+
+    pause.tv_sec = 0;
+    pause.tv_nsec = 100000000;
+    while ((client = accept4(sock, NULL, NULL, SOCK_CLOEXEC)) == -1)
+    {
+        if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS ||
+                errno == ENOMEM)
+            nanosleep(&pause, NULL);
+        else if (errno != EINTR && errno != ECONNABORTED)
+            return (-1);
+    }
+    return (client);
+}
+
+/**
+ * serveClient - Runs the command lines sent by one client.
+ * @info: The parameter struct, a private copy in this forked process.
+ * @av: The argument vector from main().
+ * @client: The connected socket.
+ *
+ * Description: Commands read the lines from the socket and write their
+ * output back to it; their stdin is /dev/null so they cannot swallow
+ * the lines that follow. A status record ends each line.
+ *
+ * Return: Does not return.
+ */
+void serveClient(shell_info *info, char **av, int client)
+{
+    int null_fd = open("/dev/null", O_RDONLY);
+
+    if (null_fd != -1)
+    {
+        dup2(null_fd, STDIN_FILENO);
+        close(null_fd);
+    }
+    dup2(client, STDOUT_FILENO);
+    dup2(client, STDERR_FILENO);
+    info->readfd = client;
+    info->serve_fd = client;
+    initJobs();
+    execShell(info, av);
+    exit(info->status);
+}
+
+/**
+ * sendStatus - Streams the exit status of a command line to the client.
+ * @info: The parameter struct.
+ *
+ * Description: The record is SERVE_RECORD, "status", the code and a
+ * newline, sent once the whole line (with its ;, && or || chain) is
+ * done and the shell's own output has been flushed ahead of it.
+ *
+ * Return: void
+ */
+void sendStatus(shell_info *info)
+{
+    char *code;
+    ssize_t sent;
+
+    if (info->serve_fd < 0)
+        return;
+
+    _putchar(BUF_FLUSH);
+    _buffered_err_putchar(BUF_FLUSH);
+    sent = send(info->serve_fd, SERVE_RECORD "status ",
+            _strlen(SERVE_RECORD "status "), MSG_NOSIGNAL);
+    code = convert_number(info->status, 10, 0);
+    if (sent > 0)
+        sent = send(info->serve_fd, code, _strlen(code), MSG_NOSIGNAL);
+    if (sent > 0)
+        send(info->serve_fd, "\n", 1, MSG_NOSIGNAL);
+}
@@ -1,6 +1,10 @@
 #ifndef _SHELL_H_
 #define _SHELL_H_
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -11,9 +15,17 @@
 #include <limits.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <spawn.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/resource.h>
 
 /* for read/write buffers */
 #define READ_BUF_SIZE 1024
+/* input read from pipes and files that are not mapped, see getline.c */
+#define INPUT_BUF_SIZE	65536
+#define INPUT_BUF_MAX	1048576
 #define WRITE_BUF_SIZE 1024
 #define BUF_FLUSH -1
 
@@ -25,8 +37,54 @@
 #define USE_GETLINE 0
 #define USE_STRTOK 0
 
+/* 1 if external commands are launched with posix_spawn() (vfork-style) */
+#define USE_SPAWN 1
+
 #define HISTORY_FILE	".shell_history"
 #define HISTORY_MAX	4096
+/* bytes of history text kept in memory, see history_ring.c */
+#define HISTORY_ARENA	262144
+/* Binary snapshot of the history, next to HISTORY_FILE */
+#define HISTORY_BIN	".bin"
+#define HISTORY_MAGIC	"HSHH"
+#define HISTORY_VERSION	1
+/* Set to share the history file with other shells as they run */
+#define SHARE_HISTORY_VAR	"HSH_SHARE_HISTORY"
+
+/* HISTCONTROL and its policies */
+#define HISTCONTROL_VAR	"HISTCONTROL="
+#define HC_IGNORESPACE	1
+#define HC_IGNOREDUPS	2
+#define HC_ERASEDUPS	4
+
+/* Ctrl-R, which starts or continues a reverse history search */
+#define SEARCH_KEY	'\022'
+/* The trigram starting at s, plus one so that none is 0 */
+#define TRIGRAM(s)	((((unsigned long)(s)[0] << 16) | ((s)[1] << 8) | \
+			(s)[2]) + 1)
+
+
+/* slots of the builtin perfect hash table, see builtin_table.c */
+#define BUILTIN_HASH_SIZE	32
+
+/* number of buckets in the command hash table, must be a power of two */
+#define CMD_HASH_SIZE	64
+
+/* set to a non-zero value to launch commands through a zygote helper */
+#define ZYGOTE_VAR	"HSH_ZYGOTE"
+#define ZYGOTE_MAX_FDS	16
+
+/* set to a non-zero value to read and parse lines ahead, see prefetch.c */
+#define PIPELINE_VAR	"HSH_PIPELINE"
+
+/* first byte of the status records of the --serve mode (ASCII RS) */
+#define SERVE_RECORD	"\036"
+
+/* compiled scripts, see script_cache.c */
+#define SCRIPT_MAGIC	"HSHC"
+#define SCRIPT_VERSION	2
+#define SCRIPT_CACHE_VAR	"XDG_CACHE_HOME"
+#define HASH_SEED	14695981039346656037UL
 
 #define WRITE_BUF_SIZE 1024
 #define NULL_TERMINATOR '\0'
@@ -47,19 +105,504 @@ typedef struct list
 	struct list *next;
 } list_t;
 
+/* src_fd of a redirection that closes its descriptor, N>&- or N<&- */
+#define REDIR_CLOSE	-2
+
+/* states of a background job */
+#define JOB_RUNNING	0
+#define JOB_STOPPED	1
+#define JOB_DONE	2
+
+/**
+ * struct job - a command started in the background with '&'
+ * @id: the job number, used as %id
+ * @pid: the process id of the job
+ * @pidfd: process file descriptor of the job, -1 if unavailable
+ * @state: JOB_RUNNING, JOB_STOPPED or JOB_DONE
+ * @status: the exit status once the job is done
+ * @cmd: the command line of the job
+ * @next: points to the next job
+ */
+typedef struct job
+{
+	int id;
+	pid_t pid;
+	int pidfd;
+	int state;
+	int status;
+	char *cmd;
+	struct job *next;
+} job_t;
+
+/**
+ * struct redir - one I/O redirection of the current command
+ * @fd: the descriptor being redirected (0 for <, 1 for >, N for N>)
+ * @flags: open() flags when the target is a file
+ * @file: the target file name, NULL for N>&M
+ * @src_fd: descriptor installed on fd: the opened file, M for N>&M, or
+ *          REDIR_CLOSE for N>&-
+ * @saved_fd: copy of fd while a builtin runs redirected, -1 otherwise
+ * @owned: on if src_fd is a here-document memfd to close with the redirection
+ * @next: the next redirection, in command order
+ */
+typedef struct redir
+{
+	int fd;
+	int flags;
+	char *file;
+	int src_fd;
+	int saved_fd;
+	int owned;
+	struct redir *next;
+} redir_t;
+
+/* token types produced by lexLine() */
+#define TOK_WORD	0
+#define TOK_PIPE	1
+#define TOK_SEMI	2
+#define TOK_AMP		3
+#define TOK_AND		4
+#define TOK_OR		5
+#define TOK_LPAREN	6
+#define TOK_RPAREN	7
+#define TOK_NEWLINE	8
+#define TOK_REDIR	9
+
+/**
+ * struct token - one token of a command line
+ * @type: TOK_WORD, TOK_REDIR or the control operator
+ * @fd: for TOK_REDIR, the descriptor written before it ("2>"), else -1
+ * @len: length of the word; for "<<" and "<<-", the index of the body
+ *       in info->heredocs
+ * @word: the word with its quotes, inside the line and NUL-terminated
+ *        once the line is complete; the operator for TOK_REDIR; NULL
+ *        for control operators
+ */
+typedef struct token
+{
+	int type;
+	int fd;
+	int len;
+	char *word;
+} token_t;
+
+/* node types of the syntax tree built by parseLine() */
+#define AST_CMD		0
+#define AST_PIPE	1
+#define AST_AND		2
+#define AST_OR		3
+#define AST_SEQ		4
+#define AST_BG		5
+#define AST_NOT		6
+#define AST_TIME	7
+#define AST_SUBSHELL	8
+#define AST_GROUP	9
+
+/* results of parseLine() */
+#define PARSE_OK		0
+#define PARSE_SYNTAX		1
+#define PARSE_INCOMPLETE	2
+
+/**
+ * struct ast_node - one node of the syntax tree of a line
+ * @type: AST_* type
+ * @left: first child: the left side, the body or the job; -1 if none
+ * @right: second child of AST_PIPE, AST_AND, AST_OR and AST_SEQ; for
+ *         AST_SUBSHELL and AST_GROUP, the first token after the closing
+ *         ")" or "}", where their redirections start
+ * @tok: index of the first token the node covers
+ * @ntok: number of tokens the node covers; an AST_CMD's words and
+ *        redirections
+ *
+ * Description: Nodes refer to each other and to the tokens by index, so
+ * a tree can be stored and run again without pointers to fix up.
+ */
+typedef struct ast_node
+{
+	int type;
+	int left;
+	int right;
+	int tok;
+	int ntok;
+} ast_node_t;
+
+/**
+ * struct parser - state of the recursive-descent parser
+ * @tokens: the tokens of the line
+ * @ntokens: the number of tokens
+ * @pos: the next token to read
+ * @nodes: the node array, room for 2 * ntokens + 1 nodes
+ * @nnodes: the number of nodes built
+ * @error: PARSE_OK, or why parsing stopped
+ * @info: the parameter struct, for error messages; NULL to parse quietly
+ */
+typedef struct parser
+{
+	token_t *tokens;
+	int ntokens;
+	int pos;
+	ast_node_t *nodes;
+	int nnodes;
+	int error;
+	struct shellInfo *info;
+} parser_t;
+
+/**
+ * struct script_header - header of a compiled script
+ * @magic: SCRIPT_MAGIC
+ * @version: SCRIPT_VERSION
+ * @size: size of the script it was compiled from
+ * @mtime: modification time of the script, seconds
+ * @mtime_nsec: modification time of the script, nanoseconds
+ * @hash: FNV-1a hash of everything after the header
+ * @source: FNV-1a hash of the script it was compiled from
+ * @nlines: number of script_line_t records after the header
+ * @ntokens: number of script_token_t records after the lines
+ * @nnodes: number of ast_node_t records after the tokens
+ * @path: offset of the absolute path of the script in the strings
+ * @strsize: size of the strings that end the file
+ */
+typedef struct script_header
+{
+	char magic[4];
+	int version;
+	long size;
+	long mtime;
+	long mtime_nsec;
+	unsigned long hash;
+	unsigned long source;
+	int nlines;
+	int ntokens;
+	int nnodes;
+	int path;
+	size_t strsize;
+} script_header_t;
+
+/**
+ * struct script_line - a command line of a compiled script
+ * @text: offset of the line as written in the strings, for the history
+ * @tok: index of its first token
+ * @ntok: number of tokens
+ * @node: index of its first node
+ * @root: root node relative to node, -1 if there is nothing to run
+ */
+typedef struct script_line
+{
+	int text;
+	int tok;
+	int ntok;
+	int node;
+	int root;
+} script_line_t;
+
+/**
+ * struct script_token - a token of a compiled script
+ * @type: as in token_t
+ * @fd: as in token_t
+ * @len: as in token_t
+ * @word: offset of the NUL-terminated word or operator in the strings,
+ *        -1 for control operators
+ */
+typedef struct script_token
+{
+	int type;
+	int fd;
+	int len;
+	int word;
+} script_token_t;
+
+/**
+ * struct script_build - a script being compiled
+ * @head: the header, counts included
+ * @lines: the lines
+ * @tokens: the tokens
+ * @nodes: the nodes
+ * @strings: the strings
+ * @caps: allocated sizes of the four arrays, in elements
+ */
+typedef struct script_build
+{
+	script_header_t head;
+	script_line_t *lines;
+	script_token_t *tokens;
+	ast_node_t *nodes;
+	char *strings;
+	size_t caps[4];
+} script_build_t;
+
+/**
+ * struct hist_entry - a line of the history
+ * @num: its history number
+ * @off: offset of its text in the arena
+ * @len: length of its text
+ * @hash: hash of its text
+ * @next: slot plus one of the next entry in its dedup bucket, 0 at the end
+ * @dead: set once erased as a duplicate; it stays until evicted
+ * @time: when it was read, 0 if unknown
+ * @usec: how long it ran, in microseconds, -1 if unknown
+ * @status: its exit status, -1 if unknown
+ * @cwd: id of the directory it was read in, see internDir(), -1 if unknown
+ */
+typedef struct hist_entry
+{
+	int num;
+	size_t off;
+	size_t len;
+	unsigned long hash;
+	int next;
+	int dead;
+	long time;
+	long usec;
+	int status;
+	int cwd;
+} hist_entry_t;
+
+/**
+ * struct gram_list - the entries whose text holds a trigram
+ * @gram: the trigram plus one, 0 for a free slot
+ * @seq: sequence numbers of the entries, oldest first
+ * @head: index of the oldest in seq
+ * @len: index just past the newest in seq
+ * @cap: allocated size of seq
+ */
+typedef struct gram_list
+{
+	unsigned long gram;
+	unsigned long *seq;
+	size_t head;
+	size_t len;
+	size_t cap;
+} gram_list_t;
+
+/**
+ * struct hist_index - trigram index of the history
+ * @slots: open-addressed table of the trigrams seen
+ * @size: number of slots, a power of two
+ * @used: number of slots taken
+ */
+typedef struct hist_index
+{
+	gram_list_t *slots;
+	size_t size;
+	size_t used;
+} hist_index_t;
+
+/**
+ * struct history - the history, a ring of entries with a text arena
+ * @entries: the entries; the oldest is at first, the others follow it
+ *           around the ring
+ * @first: slot of the oldest entry
+ * @count: number of entries
+ * @tail: offset in the arena just past the newest entry's text
+ * @base: sequence number of the oldest entry; an entry's is base plus
+ *        its position
+ * @index: where each trigram of the entries occurs, once indexed is set
+ * @indexed: set once the index is built, at the first search
+ * @buckets: slot plus one of the first live entry of each dedup bucket,
+ *           chosen by the hash of the text
+ * @dead: number of dead entries
+ * @arena: the text of the entries, NUL-terminated
+ */
+typedef struct history
+{
+	hist_entry_t entries[HISTORY_MAX];
+	int first;
+	int count;
+	size_t tail;
+	unsigned long base;
+	hist_index_t index;
+	int indexed;
+	int buckets[HISTORY_MAX];
+	int dead;
+	char arena[HISTORY_ARENA];
+} history_t;
+
+/**
+ * struct hist_header - header of the binary history snapshot
+ * @magic: HISTORY_MAGIC
+ * @version: HISTORY_VERSION
+ * @count: number of hist_record_t records after the header
+ * @text_ino: inode of the history file the snapshot was taken of
+ * @text_off: size of that file then; the lines after it are newer
+ * @text_lines: number of lines in that file then
+ * @text_seq: sequence number of the line at text_off
+ * @heap: size of the strings that end the file
+ */
+typedef struct hist_header
+{
+	char magic[4];
+	int version;
+	long count;
+	unsigned long text_ino;
+	long text_off;
+	long text_lines;
+	unsigned long text_seq;
+	size_t heap;
+} hist_header_t;
+
+/**
+ * struct hist_record - a history entry in the binary snapshot
+ * @time: when it was read, 0 if unknown
+ * @usec: how long it ran, in microseconds, -1 if unknown
+ * @status: its exit status, -1 if unknown
+ * @cwd: offset in the heap of the directory it was read in, -1 if unknown
+ * @off: offset in the heap of its text
+ * @len: length of its text
+ */
+typedef struct hist_record
+{
+	long time;
+	long usec;
+	int status;
+	int cwd;
+	size_t off;
+	size_t len;
+} hist_record_t;
+
+/**
+ * struct hist_run - a history entry that ran, as history queries sort it
+ * @name: its command name, the first word of its text
+ * @len: length of the name, 0 when entries are sorted by duration only
+ * @usec: how long it ran, in microseconds
+ * @e: the entry
+ */
+typedef struct hist_run
+{
+	char *name;
+	size_t len;
+	long usec;
+	hist_entry_t *e;
+} hist_run_t;
+
+/**
+ * struct search - state of the reverse history search
+ * @pattern: what is searched for, NULL when not searching
+ * @pos: position of the entry last found, count when none
+ * @key: set while the terminal ends a line at SEARCH_KEY
+ */
+typedef struct search
+{
+	char *pattern;
+	int pos;
+	int key;
+} search_t;
+
+/**
+ * struct input_buf - buffer of input read ahead of the current line
+ * @data: the buffer
+ * @size: its allocated size
+ * @pos: offset of the first byte not handed out yet
+ * @len: number of bytes read into it
+ * @last: number of bytes the read before that one got
+ */
+typedef struct input_buf
+{
+	char *data;
+	size_t size;
+	size_t pos;
+	size_t len;
+	size_t last;
+} input_buf_t;
+
+/**
+ * struct prefetch - a command line read and parsed while a child runs
+ * @line: the line, NULL if none is waiting
+ * @tokens: its tokens
+ * @ntokens: the number of tokens
+ * @ast: its syntax tree
+ * @root: its root node
+ * @cmd: the command resolved ahead into the hash table, or NULL
+ * @gen: info->state_gen when the line was read
+ * @pending: microseconds of work done for it while the child ran
+ * @hidden: total microseconds of work hidden behind children
+ * @lines: lines taken with their lookup still valid
+ * @discarded: lines taken after their lookup had to be dropped
+ * @owner: pid of the shell reading ahead, 0 when it is off
+ */
+typedef struct prefetch
+{
+	char *line;
+	token_t *tokens;
+	int ntokens;
+	ast_node_t *ast;
+	int root;
+	char *cmd;
+	unsigned long gen;
+	long pending;
+	long hidden;
+	int lines;
+	int discarded;
+	pid_t owner;
+} prefetch_t;
+
+/**
+ * struct cmd_usage - resources used by the last command line
+ * @real: wall-clock time in microseconds
+ * @user: user CPU time of its processes in microseconds
+ * @sys: system CPU time of its processes in microseconds
+ * @maxrss: largest resident set size of its processes in kilobytes
+ * @nvcsw: voluntary context switches of its processes
+ * @nivcsw: involuntary context switches of its processes
+ */
+typedef struct cmd_usage
+{
+	long real;
+	long user;
+	long sys;
+	long maxrss;
+	long nvcsw;
+	long nivcsw;
+} cmd_usage_t;
+
+/**
+ * struct zygote_req - a launch request sent to the zygote helper
+ * @argc: number of arguments in the packed strings
+ * @envc: number of environment entries in the packed strings
+ * @nredir: number of redirections
+ * @std: bit i is set when the shell's descriptor i, 0 to 2, is passed
+ *       first with the request; the child's is closed otherwise
+ * @len: size of the packed strings that follow the header
+ * @fds: descriptor each redirection installs
+ * @srcs: descriptor of the child to duplicate for N>&M, REDIR_CLOSE for
+ *        N>&-, -1 if the source is the next descriptor passed with the
+ *        request
+ */
+typedef struct zygote_req
+{
+	int argc;
+	int envc;
+	int nredir;
+	int std;
+	size_t len;
+	int fds[ZYGOTE_MAX_FDS];
+	int srcs[ZYGOTE_MAX_FDS];
+} zygote_req_t;
+
+/**
+ * struct zygote_reply - what the zygote reports about a launched command
+ * @pid: the child, -1 if fork() failed
+ * @status: raw wait status, in the second reply
+ * @usage: rusage of the child, in the second reply
+ */
+typedef struct zygote_reply
+{
+	pid_t pid;
+	int status;
+	struct rusage usage;
+} zygote_reply_t;
+
 /**
  *struct shellInfo - contains arguements to pass
  *@arg: a string generated from getline containing arguements
  *@argv: an array of strings generated from arg
  *@path: a string path for the current command
  *@argc: the argument count
- *@line_count: the error count
+ *@line_count: number of input lines read so far, for error messages
  *@err_num: the error code for exit()s
- *@linecount_flag: if on count this line of input
  *@fname: the program filename
  *@env: linked list local copy of environ
  *@environ: custom modified copy of environ from LL env
- *@history: the history node
+ *@history: the history ring, NULL until the first line
  *@alias: the alias node
  *@env_changed: on if environ was changed
  *@status: the return status of the last exec'd command
@@ -67,6 +610,53 @@ typedef struct list
  *@cmd_buf_type: CMD_type ||, &&, ;
  *@readfd: the fd from which to read line input
  *@histcount: the history line number count
+ *@cmd_hash: buckets of the command -> absolute path cache
+ *@pipestatus: exit status of each stage of the last pipeline
+ *@pipecount: number of entries in pipestatus, 0 after a simple command
+ *@jobs: the background job table
+ *@last_bg_pid: pid of the last background job, for $!
+ *@redirs: the I/O redirections of the current command
+ *@heredocs: memfds of the here-documents of the line, in order (fd in
+ *       num; str holds the delimiter of a body to be expanded)
+ *@usage: resources used by the last command, for the time keyword
+ *@started: when the shell started, for $SECONDS
+ *@cmd_start: when the current command started
+ *@zygote_fd: socket to the zygote launch helper, -1 if there is none
+ *@zygote_owner: pid of the shell that started the helper
+ *@serve_fd: client socket in --serve mode, -1 otherwise
+ *@arg_size: size of the line at arg; argv entries inside it are not owned
+ *@tokens: the tokens of the line at arg
+ *@ntokens: the number of tokens
+ *@tok: index of the first token of the current command
+ *@ntok: the number of tokens of the current command
+ *@ast: the nodes of the syntax tree of the line
+ *@root: the root node of the line, -1 if there is nothing to run
+ *@script: the compiled script being run, mapped read-only, or NULL
+ *@script_size: size of the mapping
+ *@script_line: index of the next line of the compiled script
+ *@input_map: the script mapped by mapInput(), or NULL
+ *@input_size: size of the mapped script
+ *@input_pos: offset of the next line in the mapped script
+ *@input: input read ahead from readfd
+ *@prefetch: the next line, prepared while a command runs
+ *@state_gen: bumped when the environment, directory or aliases change
+ *@hist_fd: the history file open for appending, -1 until the first
+ *          line, -2 if it cannot be opened
+ *@hist_lines: number of lines in the history file
+ *@search: the reverse history search under way
+ *@histcontrol: the HC_ policies of HISTCONTROL
+ *@histcontrol_gen: state_gen plus one when histcontrol was read, 0 before
+ *@hist_share: set when the history file is shared, see lockJournal()
+ *@hist_off: how far the history file was read
+ *@hist_ino: inode of the history file read, 0 if unknown
+ *@hist_seq: sequence number of the line at hist_off, counting every line
+ *           ever appended to a shared history file
+ *@hist_dirs: the directories history entries were read in; a node's num
+ *            is the id entries keep
+ *@hist_snap: offset in the history file up to which the binary snapshot
+ *            on disk holds its lines
+ *@hist_last: number of the history entry of the line being run, -1 if
+ *            it was not added to the history
  */
 typedef struct shellInfo
 {
@@ -76,10 +666,9 @@ typedef struct shellInfo
 	int argc;
 	unsigned int line_count;
 	int err_num;
-	int linecount_flag;
 	char *fname;
 	list_t *env;
-	list_t *history;
+	history_t *history;
 	list_t *alias;
 	char **environ;
 	int env_changed;
@@ -89,12 +678,60 @@ typedef struct shellInfo
 	int cmd_buf_type; /* CMD_type ||, &&, ; */
 	int readfd;
 	int histcount;
+	list_t **cmd_hash;
+	int *pipestatus;
+	int pipecount;
+	job_t *jobs;
+	pid_t last_bg_pid;
+	redir_t *redirs;
+	list_t *heredocs;
+	cmd_usage_t usage;
+	struct timespec started;
+	struct timespec cmd_start;
+	int zygote_fd;
+	pid_t zygote_owner;
+	int serve_fd;
+	size_t arg_size;
+	token_t *tokens;
+	int ntokens;
+	int tok;
+	int ntok;
+	ast_node_t *ast;
+	int root;
+	script_header_t *script;
+	size_t script_size;
+	int script_line;
+	char *input_map;
+	size_t input_size;
+	size_t input_pos;
+	input_buf_t input;
+	prefetch_t prefetch;
+	unsigned long state_gen;
+	int hist_fd;
+	int hist_lines;
+	search_t search;
+	int histcontrol;
+	unsigned long histcontrol_gen;
+	int hist_share;
+	off_t hist_off;
+	ino_t hist_ino;
+	unsigned long hist_seq;
+	list_t *hist_dirs;
+	long hist_snap;
+	int hist_last;
 } shell_info;
 
 #define INFO_INIT \
-{NULL, NULL, NULL, 0, 0, 0, 0, NULL, NULL, NULL, NULL, NULL, 0, 0, NULL, \
-	0, 0, 0}
+{NULL, NULL, NULL, 0, 0, 0, NULL, NULL, NULL, NULL, NULL, 0, 0, NULL, \
+	0, 0, 0, NULL, NULL, 0, NULL, 0, NULL, NULL, {0, 0, 0, 0, 0, 0}, \
+	{0, 0}, {0, 0}, -1, 0, -1, 0, NULL, 0, 0, 0, NULL, -1, NULL, 0, 0, \
+	NULL, 0, 0, {NULL, 0, 0, 0, 0}, \
+	{NULL, NULL, 0, NULL, -1, NULL, 0, 0, 0, 0, 0, 0}, 0, -1, 0, \
+	{NULL, 0, 0}, 0, 0, 0, 0, 0, 0, NULL, 0, -1}
+
 
+/* optional pipe capacity in bytes for F_SETPIPE_SZ, read from the env */
+#define PIPE_SIZE_VAR	"PIPESIZE"
 
 /* for command chaining */
 #define CMD_NORM	0
@@ -103,6 +740,39 @@ typedef struct shellInfo
 #define CMD_CHAIN	3
 
 
+/**
+ * struct parallel - state of one run of the parallel builtin
+ * @cmd: the command template, words of argv before the inputs
+ * @path: resolved path of the command
+ * @inputs: the input arguments, one job each
+ * @owned: on if inputs was read from stdin and must be freed
+ * @count: number of jobs
+ * @max_jobs: number of jobs kept in flight (-j)
+ * @keep_order: on to print output in input order (-k)
+ * @next_out: next job whose output is due when keep_order is on
+ * @pids: pid of each job
+ * @outfds: captured stdout of each job, -1 once printed
+ * @errfds: captured stderr of each job, -1 once printed
+ * @slots: pidfd of the job running in each slot, -1 if the slot is free
+ * @slot_job: index of the job running in each slot
+ */
+typedef struct parallel
+{
+	char **cmd;
+	char *path;
+	char **inputs;
+	int owned;
+	int count;
+	int max_jobs;
+	int keep_order;
+	int next_out;
+	pid_t *pids;
+	int *outfds;
+	int *errfds;
+	struct pollfd *slots;
+	int *slot_job;
+} parallel_t;
+
 /**
  *struct builtin - contains a builtin string and related function
  *@type: the builtin command flag
@@ -123,18 +793,187 @@ int shell_help(shell_info *info);
 
 /* builtin_emulators2.c */
 int shell_history(shell_info *info);
+int unsetAlias(shell_info *info, char *str);
+int setAlias(shell_info *info, char *str);
+int printAlias(list_t *node);
 int alias(shell_info *info);
 /* hsh.c */
 int execShell(shell_info *info, char **av);
 int findBuiltin(shell_info *info);
 void findCmd(shell_info *info);
 void forkCmd(shell_info *info);
+int runSimpleCmd(shell_info *info, char **av, int n);
+
+/* spawn.c */
+pid_t spawnProcess(shell_info *info, char *path, char **argv,
+		posix_spawn_file_actions_t *actions);
+int spawnCmd(shell_info *info);
+void runCmd(shell_info *info);
+void waitCmd(shell_info *info, pid_t pid, int pidfd);
+int exitStatus(int status);
+
+/* redirect.c */
+int parseRedirection(shell_info *info, token_t *op, char *target);
+redir_t *openRedirections(shell_info *info);
+int prepareRedirections(shell_info *info);
+void freeRedirections(shell_info *info);
+
+/* redirect_apply.c */
+void addRedirActions(shell_info *info, posix_spawn_file_actions_t *actions);
+void applyRedirections(shell_info *info);
+void restoreRedirections(redir_t *redir);
+void redirectShell(redir_t *redirs);
+int runRedirectedBuiltin(shell_info *info, builtin_table *builtin);
+
+/* heredoc.c */
+int openHereFd(void);
+int hereWrite(int fd, char *buf, size_t len);
+int sealHereFd(int fd);
+int readHeredoc(shell_info *info, char *delim, int strip_tabs);
+int hereString(char *word);
+
+/* heredoc_redir.c */
+char *hereDelimiter(token_t *word, int *quoted);
+void collectHeredocs(shell_info *info);
+void parseHereRedir(shell_info *info, redir_t *redir, token_t *op,
+		char *word);
+void freeHeredocs(shell_info *info);
+int hasHeredoc(token_t *tok, int n);
+
+/* heredoc_expand.c */
+char *expandHereText(shell_info *info, char *text);
+int expandHeredoc(shell_info *info, int fd);
+
+/* fast_copy.c */
+int copyFd(int in_fd, int out_fd);
+redir_t *lastRedir(shell_info *info, int fd);
+int catApplies(shell_info *info, redir_t *in, redir_t *out);
+int catFastPath(shell_info *info);
+
+/* pidfd.c */
+int pidfdOpen(pid_t pid);
+pid_t forkPidfd(int *pidfd);
+int siginfoStatus(siginfo_t *si);
+pid_t waitPidfd(int pidfd, pid_t pid, int *status, int options);
+pid_t waitUsage(int pidfd, pid_t pid, int *status, int options,
+		struct rusage *usage);
 
+/* serve.c */
+int serveListen(char *path);
+int serveShell(shell_info *info, char **av, char *path);
+int acceptClient(int sock);
+void serveClient(shell_info *info, char **av, int client);
+void sendStatus(shell_info *info);
+
+/* zygote.c */
+int startZygote(shell_info *info);
+void zygoteLoop(int sock);
+void zygoteExec(zygote_req_t *req, char *buf, int *fds, int nfds);
+int zygoteRequest(shell_info *info);
+int zygoteCmd(shell_info *info);
+
+/* zygote_msg.c */
+int zygoteSend(int sock, void *msg, size_t len, int *fds, int nfds);
+int zygoteRecv(int sock, void *msg, size_t len, int *fds);
+int zygoteIo(int sock, char *buf, size_t len, int out);
+char *packRequest(shell_info *info, zygote_req_t *req);
+char *unpackRequest(char *buf, zygote_req_t *req, char ***argv);
+
+/* cmd_time.c */
+long usecSince(struct timespec *start);
+void startTiming(shell_info *info);
+void addUsage(shell_info *info, struct rusage *ru);
+void stopTiming(shell_info *info);
+void printUsage(shell_info *info);
+
+/* comm_timeout.c */
+long parseDuration(char *str);
+int waitDeadline(int pidfd, long timeout_ms);
+int waitChildDeadline(pid_t pid, long timeout_ms);
+int shell_timeout(shell_info *info);
+
+/* pipeline.c */
+int countPipeStages(shell_info *info, int n);
+void setPipeSize(shell_info *info, int fd);
+int waitStages(shell_info *info, pid_t *pids, struct pollfd *stages,
+		int count);
+int runPipeline(shell_info *info, char **av, int n);
+char *pipeStatusString(shell_info *info);
+
+/* jobs.c */
+int initJobs(void);
+void sigchldHandler(int sig_num);
+job_t *addJob(shell_info *info, pid_t pid, char *cmd);
+job_t *findJob(shell_info *info, char *spec);
+void reapJobs(shell_info *info);
+
+/* jobs_update.c */
+void updateJob(job_t *job, int status);
+void removeJob(shell_info *info, job_t *job);
+void printJob(job_t *job);
+void freeJobs(shell_info *info);
+
+/* parallel.c */
+int parseParallel(shell_info *info, parallel_t *p);
+char **readParallelInput(int fd, int *count);
+void freeParallel(parallel_t *p);
+int shell_parallel(shell_info *info);
+
+/* parallel_argv.c */
+char *replaceInput(char *arg, char *input);
+char **buildJobArgv(parallel_t *p, char *input);
+
+/* parallel_run.c */
+int startParallelJob(shell_info *info, parallel_t *p, int job, int slot);
+void copyCaptured(int *fd, int to);
+void flushParallelOutput(parallel_t *p, int job);
+void finishParallelJob(shell_info *info, parallel_t *p, int job, int pidfd);
+int runParallel(shell_info *info, parallel_t *p);
+
+/* background.c */
+pid_t launchBackground(shell_info *info, char **av, int n);
+int runBackground(shell_info *info, char **av, int n);
+
+/* comm_jobs.c */
+int waitJob(job_t *job);
+int shell_jobs(shell_info *info);
+int shell_wait(shell_info *info);
+int shell_fg(shell_info *info);
+int shell_bg(shell_info *info);
+
+/* pipeline_stage.c */
+pid_t startStage(shell_info *info, char **av, int n, int in_fd, int out_fd);
+pid_t launchStage(shell_info *info, int in_fd, int out_fd);
+pid_t forkBuiltinStage(shell_info *info, builtin_table *builtin,
+		int in_fd, int out_fd);
+
+
+/* builtin_table.c */
+unsigned int builtinHash(const char *name);
+builtin_table *getBuiltin(char *name);
+
+/* comm_type.c */
+int describeCmd(shell_info *info, char *name, int verbose);
+int shell_type(shell_info *info);
+int shell_command(shell_info *info);
 
 /* path.c */
 int isCmd(shell_info *info, char *path);
 char *dupChars(const char *, int, int);
 char *findPath(shell_info *info, char *pathstr, char *cmd);
+char *resolveCmd(shell_info *info, char *cmd);
+
+/* cmd_hash.c */
+unsigned int hashName(const char *name);
+list_t *hashFind(shell_info *info, char *cmd);
+char *hashLookup(shell_info *info, char *cmd);
+list_t *hashInsert(shell_info *info, char *cmd, char *path);
+void hashClear(shell_info *info, int all);
+
+/* comm_hash.c */
+int printHashTable(shell_info *info);
+int hashCommand(shell_info *info, char *cmd);
+int shell_hash(shell_info *info);
 
 
 void _eputs(char *);
@@ -177,7 +1016,7 @@ int _erratoi(char *);
 void print_error(shell_info *, char *);
 int print_d(int, int);
 char *convert_number(long int, int, int);
-void remove_comments(char *);
+char *convert_fixed(long int, long int);
 
 /* getline.c module */
 ssize_t retrieve_input_line(shell_info *info);
@@ -187,6 +1026,8 @@ void handle_ctrl_c_signal(int);
 /* info.c module */
 void clearInfo(shell_info *info);
 void setInfo(shell_info *info, char **av);
+int setArgv(shell_info *info, int start, int count);
+void freeArgv(shell_info *info);
 void freeInfo(shell_info *info, int all);
 
 /* env.c module */
@@ -205,7 +1046,7 @@ int setEnvironment(shell_info *info, char *var, char *value);
 char *getHistoryFile(shell_info *info);
 int save_command_history(shell_info *info);
 int load_command_history(shell_info *info);
-int append_to_history(shell_info *info, char *buf, int linecount);
+int append_to_history(shell_info *info, char *buf);
 int renumberHistory(shell_info *info);
 
 /* liststr.c module */
@@ -221,14 +1062,172 @@ char **listToStrings(list_t *head);
 size_t printList(const list_t *h);
 list_t *nodeStartsWith(list_t *node, char *prefix, char c);
 ssize_t get_node_index(list_t *, list_t *);
-/* chain.c */
-int checkCommandChain(shell_info *info, char *buf, size_t *p);
-void check_chain(shell_info *, char *, size_t *, size_t, size_t);
+/* expand.c */
+char *expandWord(shell_info *info, char *word);
+int expandParam(shell_info *info, char **c, char **value);
+char *paramValue(shell_info *info, char *name, int len);
+char *appendValue(char *buf, size_t *len, char *value, size_t rest);
 int replace_alias(shell_info *);
-int replace_shell_variables(shell_info *info);
-int replace_string(char **, char *);
+
+/* lexer.c */
+int lexOperator(char *c, token_t *tok);
+int lexRedir(char *c, token_t *word, token_t *tok);
+char *skipQuoted(char *c);
+int lexWord(char *c, token_t **word, token_t *tokens, int *n);
+int lexLine(shell_info *info, char *line);
+
+/* tokens.c */
+char *tokenText(token_t *tok);
+char *commandText(shell_info *info, int tok, int ntok);
+void finishTokens(shell_info *info);
+void freeArg(shell_info *info, char *word);
+
+/* parser.c */
+int parseList(parser_t *p);
+int parseAndOr(parser_t *p);
+int parsePipeline(parser_t *p);
+int parseCommand(parser_t *p);
+int parseCompound(parser_t *p);
+
+/* parser_util.c */
+int newNode(parser_t *p, int type, int left, int right, int tok);
+int tokenIs(parser_t *p, char *word);
+int parseRedir(parser_t *p);
+void parseError(parser_t *p);
+void syntaxError(shell_info *info, char *what, int len);
+
+/* input_line.c */
+int parseLine(shell_info *info, char *line);
+int parseTokens(shell_info *info, int n, int quiet);
+int continueLine(shell_info *info, char **buf);
+
+/* exec_tree.c */
+int runLine(shell_info *info, char **av);
+int execNode(shell_info *info, char **av, int n);
+int runCommand(shell_info *info, char **av, int n);
+int runGroup(shell_info *info, char **av, int n);
+pid_t forkNode(shell_info *info, char **av, int n, int in_fd, int out_fd);
+
+/* script_cache.c */
+unsigned long hashBytes(unsigned long hash, const void *data, size_t len);
+char *scriptCachePath(shell_info *info, char *real);
+char *scriptTables(script_header_t *head, script_line_t **lines,
+		script_token_t **tokens, ast_node_t **nodes);
+int scriptValid(script_header_t *head, size_t size, char *real,
+		struct stat *st, unsigned long source);
+int mapScriptCache(shell_info *info, char *cache, char *real,
+		struct stat *st, unsigned long source);
+
+/* script_check.c */
+char *cacheDir(char *base);
+int wordsValid(script_token_t *tok, int from, int to);
+int nodeValid(ast_node_t *node, int n, script_token_t *tok, int ntok);
+int lineValid(script_header_t *head, script_line_t *line);
+int tablesValid(script_header_t *head);
+
+/* script_compile.c */
+int growArray(void **array, size_t *cap, size_t need, size_t size);
+int addString(script_build_t *b, char *s, size_t len);
+int addLine(script_build_t *b, shell_info *info, char *text);
+int compileScript(shell_info *info, char *text, size_t size,
+		script_build_t *b);
+int writeScriptCache(script_build_t *b, char *cache, char *real,
+		struct stat *st);
+
+/* script_run.c */
+char *readScript(int fd, size_t size);
+int loadScript(shell_info *info, char *path);
+ssize_t scriptLine(shell_info *info);
+void unloadScript(shell_info *info);
+
+/* input_map.c */
+int mapInput(shell_info *info);
+ssize_t mapLine(shell_info *info, char **line, int copy);
+int extendLine(shell_info *info, char **buf);
+void freeLine(shell_info *info, char *line);
+void unmapInput(shell_info *info);
+
+/* prefetch.c */
+int inputReady(shell_info *info);
+void prefetchLine(shell_info *info, int pidfd);
+int parseAhead(shell_info *info, char *line);
+void resolveAhead(shell_info *info);
+ssize_t takePrefetch(shell_info *info, char **buf);
+
+/* prefetch_mode.c */
+void startPrefetch(shell_info *info);
+void endPrefetch(shell_info *info);
+
+/* history_ring.c */
+history_t *historyRing(shell_info *info);
+void historyEvict(history_t *h);
+void historyAdd(history_t *h, char *line, int num);
+hist_entry_t *historyAt(history_t *h, int i);
+int printHistory(shell_info *info);
+
+/* history_index.c */
+gram_list_t *gramSlot(hist_index_t *idx, unsigned long gram, int add);
+int growIndex(hist_index_t *idx);
+void indexAdd(history_t *h, hist_entry_t *e, unsigned long seq);
+void indexRemove(history_t *h, hist_entry_t *e, unsigned long seq);
+void freeHistory(history_t **h);
+
+/* history_dedup.c */
+int dedupFind(history_t *h, char *line, size_t len, unsigned long hash);
+void dedupLink(history_t *h, int slot, int add);
+void historyErase(shell_info *info, int slot);
+int compactRing(shell_info *info);
+int historyKeep(shell_info *info, char *line);
+
+/* history_search.c */
+void indexHistory(history_t *h);
+int historySearch(history_t *h, char *pattern, int from);
+void searchKey(shell_info *info, int on);
+int searchStep(shell_info *info, char *text);
+ssize_t searchHistory(shell_info *info, char **buf, size_t *length,
+		ssize_t got);
+
+/* history_journal.c */
+int openJournal(shell_info *info);
+void journalHistory(shell_info *info, char *line);
+char *historyText(shell_info *info, size_t *size);
+int compactHistory(shell_info *info);
+
+/* history_bin.c */
+char *snapshotPath(shell_info *info);
+int internDir(shell_info *info, char *dir);
+long loadSnapshot(shell_info *info, struct stat *text);
+char *snapshotHeap(shell_info *info, hist_record_t *rec, size_t *size);
+int writeSnapshot(shell_info *info, struct stat *text);
+
+/* comm_history.c */
+int historyOptions(shell_info *info);
+int exportHistory(shell_info *info, char *file);
+int importHistory(shell_info *info, char *file);
+int printMatches(shell_info *info, char *pattern);
+
+/* history_stats.c */
+void historyResult(shell_info *info, long usec);
+int byRun(const void *a, const void *b);
+hist_run_t *historyRuns(shell_info *info, int names, int *n);
+void putDuration(long usec);
+void printRun(history_t *h, hist_entry_t *e);
+
+/* comm_history_stats.c */
+int printSlowest(shell_info *info, char *count);
+int printFailed(shell_info *info);
+int printStats(shell_info *info);
+void printPercentiles(hist_run_t *runs, int n);
+
+/* history_share.c */
+unsigned long historyHeader(char *buf, char **rest);
+int seekJournal(shell_info *info);
+int lockJournal(shell_info *info);
+void syncHistory(shell_info *info);
+char *sharedText(shell_info *info, size_t *size);
 
 void free_string_array(char **array);
 
 void prune_history(shell_info *info, int max_entries);
+int histControl(shell_info *info);
 #endif
@@ -12,25 +12,26 @@ int execShell(shell_info *info, char **av)
 	ssize_t r = 0;
 	int builtin_ret = 0;
 
+	info->fname = av[0];
 	while (r != -1 && builtin_ret != -2)
 	{
         clearInfo(info);
+		reapJobs(info);
 		if (interactive(info))
 			_puts("$ ");
         _buffered_err_putchar(BUF_FLUSH);
 		r = retrieve_input_line(info);
 		if (r != -1)
-		{
-            setInfo(info, av);
-			builtin_ret = findBuiltin(info);
-			if (builtin_ret == -1)
-                findCmd(info);
-		}
+			builtin_ret = runLine(info, av);
 		else if (interactive(info))
 			_putchar('\n');
+		if (r != -1 && builtin_ret != -2)
+			sendStatus(info);
         freeInfo(info, 0);
 	}
-    save_command_history(info);
+    if (info->serve_fd < 0)
+        save_command_history(info);
+    endPrefetch(info);
     freeInfo(info, 1);
 	if (!interactive(info) && info->status)
 		exit(info->status);
@@ -47,6 +48,9 @@ int execShell(shell_info *info, char **av)
  * findBuiltin - finds a builtin command
  * @info: the parameter & return info struct
  *
+ * Description: what the builtin returns becomes its status, $?, unless
+ * it is exit.
+ *
  * Return: -1 if builtin not found,
  *			0 if builtin executed successfully,
  *			1 if builtin found but not successful,
@@ -54,27 +58,42 @@ int execShell(shell_info *info, char **av)
  */
 int findBuiltin(shell_info *info)
 {
-	int i, built_in_ret = -1;
-	builtin_table builtintbl[] = {
-		{"exit",     exitShell},
-		{"env",      shellEnvironment},
-		{"help",     shell_help},
-		{"history",  shell_history},
-		{"setenv",   _mysetenv},
-		{"unsetenv", _myunsetenv},
-		{"cd",       shell_cd},
-		{"alias",    alias},
-		{NULL, NULL}
-	};
+	builtin_table *builtin = getBuiltin(info->argv[0]);
+	int ret;
 
-	for (i = 0; builtintbl[i].type; i++)
-		if (_strcmp(info->argv[0], builtintbl[i].type) == 0)
-		{
-			info->line_count++;
-			built_in_ret = builtintbl[i].func(info);
-			break;
-		}
-	return (built_in_ret);
+	if (!builtin)
+		return (-1);
+	if (info->redirs)
+		ret = runRedirectedBuiltin(info, builtin);
+	else
+		ret = builtin->func(info);
+	if (ret >= 0)
+		info->status = ret;
+	return (ret);
+}
+
+/**
+ * runSimpleCmd - runs a simple command in the foreground
+ * @info: the parameter & return info struct
+ * @av: the argument vector from main()
+ * @n: the AST_CMD node of the command
+ *
+ * Return: the return value of the builtin, or -1 if none was run
+ */
+int runSimpleCmd(shell_info *info, char **av, int n)
+{
+	int builtin_ret;
+
+	info->tok = info->ast[n].tok;
+	info->ntok = info->ast[n].ntok;
+	setInfo(info, av);
+	info->pipecount = 0;
+	if (prepareRedirections(info) == -1 || !info->argc)
+		return (-1);
+	builtin_ret = findBuiltin(info);
+	if (builtin_ret == -1)
+		findCmd(info);
+	return (builtin_ret);
 }
 
 /**
@@ -86,32 +105,25 @@ int findBuiltin(shell_info *info)
 void findCmd(shell_info *info)
 {
 	char *path = NULL;
-	int i, k;
 
 	info->path = info->argv[0];
-	if (info->linecount_flag == 1)
-	{
-		info->line_count++;
-		info->linecount_flag = 0;
-	}
-	for (i = 0, k = 0; info->arg[i]; i++)
-		if (!is_delim(info->arg[i], " \t\n"))
-			k++;
-	if (!k)
+	if (!info->argc)
+		return;
+	if (info->redirs && catFastPath(info) == 0)
 		return;
 
-	path = findPath(info, getEnvironment(info, "PATH="), info->argv[0]);
+	path = resolveCmd(info, info->argv[0]);
 	if (path)
 	{
 		info->path = path;
-        forkCmd(info);
+        runCmd(info);
 	}
 	else
 	{
 		if ((interactive(info) || getEnvironment(info, "PATH=")
              || info->argv[0][0] == '/') && isCmd(info, info->argv[0]))
-            forkCmd(info);
-		else if (*(info->arg) != '\n')
+            runCmd(info);
+		else
 		{
 			info->status = 127;
 			print_error(info, "not found\n");
@@ -123,13 +135,16 @@ void findCmd(shell_info *info)
  * forkCmd - forks a an exec thread to run cmd
  * @info: the parameter & return info struct
  *
+ * Used as the fallback of runCmd() when work has to happen in the child.
+ *
  * Return: void
  */
 void forkCmd(shell_info *info)
 {
 	pid_t child_pid;
+	int pidfd;
 
-	child_pid = fork();
+	child_pid = forkPidfd(&pidfd);
 	if (child_pid == -1)
 	{
 		/* TODO: PUT ERROR FUNCTION */
@@ -138,6 +153,7 @@ void forkCmd(shell_info *info)
 	}
 	if (child_pid == 0)
 	{
+		applyRedirections(info);
 		if (execve(info->path, info->argv, get_environ(info)) == -1)
 		{
             freeInfo(info, 1);
@@ -148,13 +164,5 @@ void forkCmd(shell_info *info)
 		/* TODO: PUT ERROR FUNCTION */
 	}
 	else
-	{
-		wait(&(info->status));
-		if (WIFEXITED(info->status))
-		{
-			info->status = WEXITSTATUS(info->status);
-			if (info->status == 126)
-				print_error(info, "Permission denied\n");
-		}
-	}
+		waitCmd(info, child_pid, pidfd);
 }
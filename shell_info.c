@@ -19,29 +19,61 @@ void clearInfo(shell_info *info)
  */
 void setInfo(shell_info *info, char **av)
 {
-	int i = 0;
-
 	info->fname = av[0];
-	if (info->arg)
+	setArgv(info, info->tok, info->ntok);
+}
+
+/**
+ * setArgv - builds info->argv and info->redirs from a simple command
+ * @info: struct address
+ * @start: index of the first token in info->tokens
+ * @count: number of tokens, words and redirections
+ *
+ * Description: words are expanded one by one; those with nothing to
+ * expand point into the command line, so the array is usually the only
+ * allocation. An alias in argv[0] is replaced last.
+ *
+ * Return: 0 on success, -1 on allocation failure
+ */
+int setArgv(shell_info *info, int start, int count)
+{
+	token_t *tok = info->tokens + start;
+	char *word;
+	int i;
+
+	info->argv = malloc(sizeof(char *) * (count + 1));
+	info->argc = 0;
+	if (!info->argv)
+		return (-1);
+	for (i = 0; i < count; i++)
 	{
-		info->argv = strtow(info->arg, " \t");
-		if (!info->argv)
+		if (tok[i].type == TOK_REDIR)
 		{
-
-			info->argv = malloc(sizeof(char *) * 2);
-			if (info->argv)
-			{
-				info->argv[0] = _strdup(info->arg);
-				info->argv[1] = NULL;
-			}
+			parseRedirection(info, tok + i,
+					expandWord(info, tok[i + 1].word));
+			i++;
 		}
-		for (i = 0; info->argv && info->argv[i]; i++)
-			;
-		info->argc = i;
-
-		replace_alias(info);
-        replace_shell_variables(info);
+		else if ((word = expandWord(info, tok[i].word)))
+			info->argv[info->argc++] = word;
 	}
+	info->argv[info->argc] = NULL;
+	if (info->argc)
+		replace_alias(info);
+	return (0);
+}
+
+/**
+ * freeArgv - frees info->argv and the entries expansions allocated
+ * @info: struct address
+ */
+void freeArgv(shell_info *info)
+{
+	int i;
+
+	for (i = 0; info->argv && info->argv[i]; i++)
+		freeArg(info, info->argv[i]);
+	free(info->argv);
+	info->argv = NULL;
 }
 
 /**
@@ -51,22 +83,31 @@ void setInfo(shell_info *info, char **av)
  */
 void freeInfo(shell_info *info, int all)
 {
-	ffree(info->argv);
-	info->argv = NULL;
+	freeArgv(info);
 	info->path = NULL;
+	freeRedirections(info);
 	if (all)
 	{
-		if (!info->cmd_buf)
-			free(info->arg);
 		if (info->env)
             free_linked_list(&(info->env));
-		if (info->history)
-            free_linked_list(&(info->history));
+		freeHistory(&info->history);
+		bfree((void **)&(info->search.pattern));
+		free_linked_list(&info->hist_dirs);
 		if (info->alias)
             free_linked_list(&(info->alias));
+		hashClear(info, 1);
+		bfree((void **)&(info->pipestatus));
+		freeJobs(info);
+		freeHeredocs(info);
+		bfree((void **)&(info->tokens));
+		bfree((void **)&(info->ast));
+		unloadScript(info);
 		ffree(info->environ);
 			info->environ = NULL;
-		bfree((void **)info->cmd_buf);
+		if (info->cmd_buf)
+			freeLine(info, *info->cmd_buf), *info->cmd_buf = NULL;
+		unmapInput(info);
+		bfree((void **)&(info->input.data));
 		if (info->readfd > 2)
 			close(info->readfd);
 		_putchar(BUF_FLUSH);
@@ -0,0 +1,133 @@
+#include "shell.h"
+
+/**
+ * spawnProcess - Launches a program without copying the shell's address space.
+ * @info: The parameter struct, used for the exported environment.
+ * @path: Absolute or relative path of the program to run.
+ * @argv: NULL-terminated argument vector for the program.
+ * @actions: fd setup (dup2/close) to run in the child, or NULL to apply
+ *           just the redirections of the current command.
+ *
+ * Description: glibc implements posix_spawn() with clone(CLONE_VM |
+ * CLONE_VFORK), so the page tables of the env, history and alias lists
+ * are never duplicated. Errors from execve() in the child are reported
+ * back to the parent through the return value.
+ *
+ * Return: pid of the child, or -1 with errno set on failure.
+ */
+pid_t spawnProcess(shell_info *info, char *path, char **argv,
+        posix_spawn_file_actions_t *actions)
+{
+    posix_spawn_file_actions_t redir_actions;
+    pid_t child_pid;
+    int err;
+
+    if (!actions && info->redirs)
+    {
+        posix_spawn_file_actions_init(&redir_actions);
+        addRedirActions(info, &redir_actions);
+    }
+    err = posix_spawn(&child_pid, path, actions ? actions :
+            (info->redirs ? &redir_actions : NULL), NULL, argv,
+            get_environ(info));
+    if (!actions && info->redirs)
+        posix_spawn_file_actions_destroy(&redir_actions);
+    if (err)
+    {
+        errno = err;
+        return (-1);
+    }
+
+    return (child_pid);
+}
+
+/**
+ * spawnCmd - Runs info->path through the fast spawn path and waits for it.
+ * @info: The parameter & return info struct.
+ *
+ * Return: 0 if the command was launched, -1 if the caller should fall
+ *         back to forkCmd() (exec errors need the child-side mapping).
+ */
+int spawnCmd(shell_info *info)
+{
+    pid_t child_pid;
+
+    child_pid = spawnProcess(info, info->path, info->argv, NULL);
+    if (child_pid == -1)
+        return (-1);
+
+    waitCmd(info, child_pid, pidfdOpen(child_pid));
+    return (0);
+}
+
+/**
+ * runCmd - Launches the resolved external command in info->path.
+ * @info: The parameter & return info struct.
+ *
+ * Description: Goes through the zygote helper when one is running, else
+ * uses the spawn engine when USE_SPAWN is set, and falls back to the
+ * classic fork()/execve() path whenever spawning is not possible. What
+ * earlier builtins of the line printed is flushed first, so that it
+ * comes out before the command's own output.
+ *
+ * Return: void
+ */
+void runCmd(shell_info *info)
+{
+    _putchar(BUF_FLUSH);
+    _buffered_err_putchar(BUF_FLUSH);
+    if (zygoteCmd(info) == 0)
+        return;
+#if USE_SPAWN
+    if (spawnCmd(info) == 0)
+        return;
+#endif
+    forkCmd(info);
+}
+
+/**
+ * waitCmd - Waits for a child and stores its exit status in info->status.
+ * @info: The parameter & return info struct.
+ * @pid: The child to wait for.
+ * @pidfd: The pidfd of the child, or -1; it is closed here.
+ *
+ * Description: Only the given child is reaped, so background jobs and
+ * pipeline stages never have their status stolen. Its rusage is added to
+ * the figures reported by the time keyword. With HSH_PIPELINE set, the
+ * next line is prepared before blocking (see prefetchLine()).
+ *
+ * Return: void
+ */
+void waitCmd(shell_info *info, pid_t pid, int pidfd)
+{
+    struct rusage usage;
+    int status;
+    pid_t ret;
+
+    prefetchLine(info, pidfd);
+    ret = waitUsage(pidfd, pid, &status, 0, &usage);
+    if (pidfd >= 0)
+        close(pidfd);
+    if (ret == -1)
+        return;
+    addUsage(info, &usage);
+
+    info->status = exitStatus(status);
+    if (WIFEXITED(status) && info->status == 126)
+        print_error(info, "Permission denied\n");
+}
+
+/**
+ * exitStatus - Converts a raw wait status into a shell exit status.
+ * @status: The status filled in by waitpid().
+ *
+ * Return: The exit code, or 128 + signal number if the child was killed.
+ */
+int exitStatus(int status)
+{
+    if (WIFEXITED(status))
+        return (WEXITSTATUS(status));
+    if (WIFSIGNALED(status))
+        return (128 + WTERMSIG(status));
+    return (status);
+}
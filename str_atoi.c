@@ -95,3 +95,28 @@ int _erratoi(char *s)
 	}
 	return (result);
 }
+
+
+/**
+ * convert_fixed - converts a number of small units to a decimal number
+ * of larger ones with three decimals, such as 1234567 usec to "1.234"
+ * @num: the number, not negative
+ * @unit: how many small units make one large unit, at least 1000
+ *
+ * Return: string
+ */
+char *convert_fixed(long int num, long int unit)
+{
+	static char buffer[56];
+	long int frac = num % unit / (unit / 1000);
+	char *end;
+
+	_strcpy(buffer, convert_number(num / unit, 10, 0));
+	end = buffer + _strlen(buffer);
+	end[0] = '.';
+	end[1] = '0' + frac / 100;
+	end[2] = '0' + frac / 10 % 10;
+	end[3] = '0' + frac % 10;
+	end[4] = '\0';
+	return (buffer);
+}
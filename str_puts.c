@@ -31,7 +31,7 @@ int _putchar(char c)
 	static int i;
 	static char buf[WRITE_BUF_SIZE];
 
-	if (c == BUF_FLUSH || i >= WRITE_BUF_SIZE)
+	if ((c == BUF_FLUSH || i >= WRITE_BUF_SIZE) && i)
 	{
 		write(1, buf, i);
 		i = 0;
@@ -0,0 +1,12 @@
+setenv NAME world
+cat <<END
+hello $NAME, ${NAME}! "$NAME" '$NAME'
+\$NAME \\ \`x\` joined \
+line, $UNSET.
+END
+false; cat <<END
+status $?
+END
+cat <<-END
+	tabs $NAME
+	END
@@ -0,0 +1,13 @@
+setenv NAME world
+cat <<'END'
+single $NAME ${NAME} $? \$NAME \
+END
+cat <<"END"
+double $NAME $$
+END
+cat <<\END
+backslash $NAME
+END
+cat <<E'N'D
+partly $NAME
+END
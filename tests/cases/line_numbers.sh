@@ -0,0 +1,10 @@
+echo one
+
+# a comment, then a line that only has spaces
+   
+nosuch1
+echo "two
+three" # a quoted newline continues the line
+nosuch2
+	# indented comment
+nosuch3
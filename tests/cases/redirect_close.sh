@@ -0,0 +1,7 @@
+ls /nonexistent-dir 2>&-
+echo "status $?"
+ls /proc/self/fd/ <&- >/dev/null
+echo "status $?"
+test -e - || echo "no file named -"
+cat < redirect_close.sh > /dev/full
+echo "status $?"
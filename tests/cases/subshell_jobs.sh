@@ -0,0 +1,5 @@
+sleep 0.3 &
+(jobs; wait %1; echo "subshell wait $?")
+jobs
+wait %1
+echo "wait $?"
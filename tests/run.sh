@@ -0,0 +1,48 @@
+#!/bin/sh
+# Builds the shell of the working tree and runs each script of
+# tests/cases three ways: as a file, on standard input, and as a
+# compiled script loaded from the cache. Every time, its output and
+# error messages must match the .out file next to it, where the shell
+# is called "hsh".
+#
+# usage: tests/run.sh [case...]
+
+top=$(cd "$(dirname "$0")/.." && pwd)
+out=$(mktemp -d /tmp/hsh-test.XXXXXX)
+trap 'rm -rf "$out"' EXIT
+(cd "$top" && gcc -Wall -Werror -Wextra -pedantic -std=gnu89 *.c \
+	-o "$out/hsh") || exit 1
+cd "$top/tests/cases" || exit 1
+if [ $# -eq 0 ]; then
+	set -- $(ls *.sh | sed 's/\.sh$//')
+fi
+
+# run mode script: runs the script the given way, output on stdout
+run() {
+	mkdir -p "$out/home"
+	case $1 in
+	file)	env -i PATH=/usr/bin:/bin HOME="$out/home" \
+			XDG_CACHE_HOME=/dev/null "$out/hsh" "$2" ;;
+	stdin)	env -i PATH=/usr/bin:/bin HOME="$out/home" \
+			XDG_CACHE_HOME=/dev/null "$out/hsh" < "$2" ;;
+	compiled)
+		env -i PATH=/usr/bin:/bin HOME="$out/home" \
+			XDG_CACHE_HOME="$out/cache" "$out/hsh" "$2" >/dev/null 2>&1
+		env -i PATH=/usr/bin:/bin HOME="$out/home" \
+			XDG_CACHE_HOME="$out/cache" "$out/hsh" "$2" ;;
+	esac 2>&1 | sed "s|$out/hsh|hsh|g"
+}
+
+fail=0
+for t in "$@"; do
+	for mode in file stdin compiled; do
+		if run $mode "$t.sh" | diff -u "$t.out" - > "$out/diff"; then
+			echo "ok   $t ($mode)"
+		else
+			echo "FAIL $t ($mode)"
+			cat "$out/diff"
+			fail=1
+		fi
+	done
+done
+exit $fail
@@ -0,0 +1,102 @@
+#include "shell.h"
+#include <stdlib.h>
+
+/**
+ * tokenText - Gives the text of a token.
+ * @tok: The token, from a line finishTokens() has terminated.
+ *
+ * Return: The operator, or the word with its quotes.
+ */
+char *tokenText(token_t *tok)
+{
+    switch (tok->type)
+    {
+    case TOK_PIPE:
+        return ("|");
+    case TOK_SEMI:
+    case TOK_NEWLINE:
+        return (";");
+    case TOK_AMP:
+        return ("&");
+    case TOK_AND:
+        return ("&&");
+    case TOK_OR:
+        return ("||");
+    case TOK_LPAREN:
+        return ("(");
+    case TOK_RPAREN:
+        return (")");
+    default:
+        return (tok->word);
+    }
+}
+
+/**
+ * commandText - Rebuilds the text of a run of tokens.
+ * @info: The parameter struct holding the tokens.
+ * @tok: Index of the first token, usually the start of a node.
+ * @ntok: Number of tokens.
+ *
+ * Description: Used where a command is needed as one string again, such
+ * as the command shown by the jobs builtin. A redirection is glued to the
+ * descriptor before it and the word after it.
+ *
+ * Return: Allocated string, or NULL on failure.
+ */
+char *commandText(shell_info *info, int tok, int ntok)
+{
+    token_t *t = info->tokens + tok;
+    size_t size = 1;
+    char *text;
+    int i;
+
+    for (i = 0; i < ntok; i++)
+        size += _strlen(tokenText(t + i)) + 12;
+    text = malloc(size);
+    if (!text)
+        return (NULL);
+
+    text[0] = '\0';
+    for (i = 0; i < ntok; i++)
+    {
+        if (i && t[i - 1].type != TOK_REDIR)
+            _strcat(text, " ");
+        if (t[i].type == TOK_REDIR && t[i].fd >= 0)
+            _strcat(text, convert_number(t[i].fd, 10, 0));
+        _strcat(text, tokenText(t + i));
+    }
+    return (text);
+}
+
+/**
+ * finishTokens - NUL-terminates the words of a complete line in place.
+ * @info: The parameter struct holding the tokens.
+ *
+ * Description: Lexing leaves the line untouched so that an incomplete
+ * line can be continued and lexed again. The byte after a word is a
+ * blank or an operator, which the tokens already record.
+ *
+ * Return: void
+ */
+void finishTokens(shell_info *info)
+{
+    int i;
+
+    for (i = 0; i < info->ntokens; i++)
+        if (info->tokens[i].type == TOK_WORD)
+            info->tokens[i].word[info->tokens[i].len] = '\0';
+}
+
+/**
+ * freeArg - Frees an argv entry unless it points into the command line.
+ * @info: The parameter struct holding the line in info->arg.
+ * @word: The entry.
+ *
+ * Return: void
+ */
+void freeArg(shell_info *info, char *word)
+{
+    if (info->arg && word >= info->arg && word < info->arg + info->arg_size)
+        return;
+    free(word);
+}
@@ -0,0 +1,230 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <sys/socket.h>
+
+/**
+ * startZygote - Forks the launch helper when HSH_ZYGOTE is set.
+ * @info: The parameter struct; the socket is kept in info->zygote_fd.
+ *
+ * Description: Called before the env, history and alias lists are built,
+ * so the helper stays tiny and each fork() it makes copies almost no
+ * page tables, however large the shell itself grows. The socket is kept
+ * above the standard descriptors, so one the shell was started without
+ * stays closed rather than becoming the socket.
+ *
+ * Return: 0 on success or when disabled, -1 on failure.
+ */
+int startZygote(shell_info *info)
+{
+    char *on = getenv(ZYGOTE_VAR);
+    int sv[2], i, fd;
+    pid_t pid;
+
+    if (!on || !*on || !_strcmp(on, "0"))
+        return (0);
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) == -1)
+        return (-1);
+    for (i = 0; i < 2; i++)
+        if (sv[i] <= STDERR_FILENO)
+        {
+            fd = fcntl(sv[i], F_DUPFD_CLOEXEC, STDERR_FILENO + 1);
+            close(sv[i]);
+            sv[i] = fd;
+        }
+    if (sv[0] == -1 || sv[1] == -1)
+        return (close(sv[0]), close(sv[1]), -1);
+
+    pid = fork();
+    if (pid == 0)
+    {
+        close(sv[0]);
+        signal(SIGINT, SIG_IGN);
+        signal(SIGQUIT, SIG_IGN);
+        zygoteLoop(sv[1]);
+        _exit(0);
+    }
+    close(sv[1]);
+    if (pid == -1)
+        return (close(sv[0]), -1);
+    info->zygote_fd = sv[0];
+    info->zygote_owner = getpid();
+    return (0);
+}
+
+/**
+ * zygoteLoop - Serves launch requests until the shell goes away.
+ * @sock: The helper's end of the socket.
+ *
+ * Description: For each request the helper forks, sends back the child's
+ * pid with a pidfd, then waits for it and sends its status and rusage.
+ *
+ * Return: void, when the socket is closed.
+ */
+void zygoteLoop(int sock)
+{
+    zygote_req_t req;
+    zygote_reply_t reply;
+    int fds[ZYGOTE_MAX_FDS], nfds, pidfd, status;
+    char *buf;
+
+    while ((nfds = zygoteRecv(sock, &req, sizeof(req), fds)) != -1)
+    {
+        buf = malloc(req.len);
+        if (!buf || zygoteIo(sock, buf, req.len, 0) == -1)
+            return;
+        _memset((char *)&reply, 0, sizeof(reply));
+        reply.pid = fork();
+        if (reply.pid == 0)
+            zygoteExec(&req, buf, fds, nfds);
+        while (nfds > 0)
+            close(fds[--nfds]);
+        free(buf);
+
+        pidfd = pidfdOpen(reply.pid);
+        zygoteSend(sock, &reply, sizeof(reply), &pidfd, pidfd >= 0);
+        if (pidfd >= 0)
+            close(pidfd);
+        if (reply.pid > 0 && wait4(reply.pid, &status, 0, &reply.usage) > 0)
+            reply.status = status;
+        if (reply.pid > 0)
+            zygoteSend(sock, &reply, sizeof(reply), NULL, 0);
+    }
+}
+
+/**
+ * zygoteExec - Runs a request in the helper's freshly forked child.
+ * @req: The request header.
+ * @buf: The packed path, cwd, argv and environment.
+ * @fds: Descriptors received for the redirections.
+ * @nfds: Number of received descriptors.
+ *
+ * Description: The shell's standard descriptors are installed first, as
+ * a redirected group or builtin may have changed them since the helper
+ * was forked. Redirections are then replayed in command order; "N>&M"
+ * ones duplicate the child's own M, so ">f 2>&1" behaves as in the
+ * shell.
+ *
+ * Return: Does not return.
+ */
+void zygoteExec(zygote_req_t *req, char *buf, int *fds, int nfds)
+{
+    char **argv, *cwd = unpackRequest(buf, req, &argv);
+    int i, next = 0;
+
+    signal(SIGINT, SIG_DFL);
+    signal(SIGQUIT, SIG_DFL);
+    if (!cwd)
+        _exit(1);
+    if (chdir(cwd) == -1)
+        perror(cwd);
+    for (i = 0; i < 3; i++)
+    {
+        if (!(req->std & 1 << i))
+            close(i);
+        else if (next < nfds)
+            dup2(fds[next++], i);
+    }
+    for (i = 0; i < req->nredir; i++)
+    {
+        if (req->srcs[i] >= 0)
+            dup2(req->srcs[i], req->fds[i]);
+        else if (req->srcs[i] == REDIR_CLOSE)
+            close(req->fds[i]);
+        else if (next < nfds)
+            dup2(fds[next++], req->fds[i]);
+    }
+    execve(buf, argv, argv + req->argc + 1);
+    _exit(errno == EACCES ? 126 : 1);
+}
+
+/**
+ * zygoteRequest - Sends info->path, its arguments and redirections.
+ * @info: The parameter struct.
+ *
+ * Description: The shell's descriptors 0 to 2 that are open go first,
+ * followed by the files the redirections opened.
+ *
+ * Return: 0 on success, -1 if the request could not be sent.
+ */
+int zygoteRequest(shell_info *info)
+{
+    zygote_req_t req;
+    redir_t *redir;
+    int fds[ZYGOTE_MAX_FDS], nfds = 0, ret = -1, i;
+    char *buf;
+
+    _memset((char *)&req, 0, sizeof(req));
+    for (i = 0; i < 3; i++)
+        if (fcntl(i, F_GETFD) != -1)
+        {
+            fds[nfds++] = i;
+            req.std |= 1 << i;
+        }
+    for (redir = info->redirs; redir; redir = redir->next, req.nredir++)
+    {
+        if (req.nredir == ZYGOTE_MAX_FDS || nfds == ZYGOTE_MAX_FDS)
+            return (-1);
+        req.fds[req.nredir] = redir->fd;
+        req.srcs[req.nredir] = -1;
+        if (redir->file || redir->owned)
+            fds[nfds++] = redir->src_fd;
+        else
+            req.srcs[req.nredir] = redir->src_fd;
+    }
+
+    buf = packRequest(info, &req);
+    if (buf && zygoteSend(info->zygote_fd, &req, sizeof(req), fds, nfds) == 0
+            && zygoteIo(info->zygote_fd, buf, req.len, 1) == 0)
+        ret = 0;
+    free(buf);
+    return (ret);
+}
+
+/**
+ * zygoteCmd - Runs info->path through the zygote and waits for it.
+ * @info: The parameter & return info struct.
+ *
+ * Description: A helper that has gone away is dropped and the caller
+ * falls back to spawning the command itself. Forked copies of the shell
+ * never use the helper, so requests on the socket cannot interleave.
+ *
+ * Return: 0 if the command was run, -1 if the caller should launch it.
+ */
+int zygoteCmd(shell_info *info)
+{
+    zygote_reply_t reply;
+    struct pollfd exited;
+    int fds[ZYGOTE_MAX_FDS], pidfd, got;
+
+    if (info->zygote_fd < 0 || getpid() != info->zygote_owner)
+        return (-1);
+    got = zygoteRequest(info);
+    if (got != -1)
+        got = zygoteRecv(info->zygote_fd, &reply, sizeof(reply), fds);
+    if (got == -1)
+    {
+        close(info->zygote_fd);
+        info->zygote_fd = -1;
+        return (-1);
+    }
+    pidfd = got > 0 ? fds[0] : -1;
+    if (reply.pid <= 0)
+        return (-1);
+
+    exited.fd = pidfd;
+    exited.events = POLLIN;
+    if (zygoteRecv(info->zygote_fd, &reply, sizeof(reply), NULL) == -1)
+    {
+        /* the helper died: still wait for the command to finish */
+        while (pidfd >= 0 && poll(&exited, 1, -1) == -1 && errno == EINTR)
+            ;
+        reply.status = 1 << 8;
+    }
+    if (pidfd >= 0)
+        close(pidfd);
+    info->status = exitStatus(reply.status);
+    addUsage(info, &reply.usage);
+    if (WIFEXITED(reply.status) && info->status == 126)
+        print_error(info, "Permission denied\n");
+    return (0);
+}
@@ -0,0 +1,183 @@
+#include "shell.h"
+#include <stdlib.h>
+#include <sys/socket.h>
+
+/**
+ * zygoteSend - Sends a fixed-size message, optionally passing descriptors.
+ * @sock: The zygote socket.
+ * @msg: The message.
+ * @len: Size of the message.
+ * @fds: Descriptors to pass with SCM_RIGHTS.
+ * @nfds: Number of descriptors, at most ZYGOTE_MAX_FDS.
+ *
+ * Return: 0 on success, -1 on failure.
+ */
+int zygoteSend(int sock, void *msg, size_t len, int *fds, int nfds)
+{
+    char control[CMSG_SPACE(sizeof(int) * ZYGOTE_MAX_FDS)];
+    struct msghdr hdr;
+    struct iovec iov;
+    struct cmsghdr *cmsg;
+
+    _memset((char *)&hdr, 0, sizeof(hdr));
+    iov.iov_base = msg;
+    iov.iov_len = len;
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    if (nfds > 0)
+    {
+        _memset(control, 0, sizeof(control));
+        hdr.msg_control = control;
+        hdr.msg_controllen = CMSG_SPACE(sizeof(int) * nfds);
+        cmsg = CMSG_FIRSTHDR(&hdr);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * nfds);
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * nfds);
+    }
+
+    if (sendmsg(sock, &hdr, MSG_NOSIGNAL) != (ssize_t)len)
+        return (-1);
+    return (0);
+}
+
+/**
+ * zygoteRecv - Receives a fixed-size message and the descriptors with it.
+ * @sock: The zygote socket.
+ * @msg: Buffer for the message.
+ * @len: Size of the message.
+ * @fds: Buffer for at least ZYGOTE_MAX_FDS descriptors, or NULL.
+ *
+ * Description: Received descriptors are close-on-exec.
+ *
+ * Return: The number of descriptors received, or -1 on failure or EOF.
+ */
+int zygoteRecv(int sock, void *msg, size_t len, int *fds)
+{
+    char control[CMSG_SPACE(sizeof(int) * ZYGOTE_MAX_FDS)];
+    struct msghdr hdr;
+    struct iovec iov;
+    struct cmsghdr *cmsg;
+    ssize_t got;
+    int nfds = 0;
+
+    _memset((char *)&hdr, 0, sizeof(hdr));
+    iov.iov_base = msg;
+    iov.iov_len = len;
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control;
+    hdr.msg_controllen = sizeof(control);
+    do {
+        got = recvmsg(sock, &hdr, MSG_WAITALL | MSG_CMSG_CLOEXEC);
+    } while (got == -1 && errno == EINTR);
+    if (got != (ssize_t)len)
+        return (-1);
+
+    for (cmsg = CMSG_FIRSTHDR(&hdr); cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg))
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+        {
+            nfds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            if (fds)
+                memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * nfds);
+        }
+    return (nfds);
+}
+
+/**
+ * zygoteIo - Transfers a whole buffer over the zygote socket.
+ * @sock: The zygote socket.
+ * @buf: The buffer.
+ * @len: Number of bytes.
+ * @out: 1 to send the buffer, 0 to receive into it.
+ *
+ * Return: 0 on success, -1 on failure or EOF.
+ */
+int zygoteIo(int sock, char *buf, size_t len, int out)
+{
+    ssize_t n;
+
+    while (len > 0)
+    {
+        if (out)
+            n = send(sock, buf, len, MSG_NOSIGNAL);
+        else
+            n = recv(sock, buf, len, MSG_WAITALL);
+        if (n == -1 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return (-1);
+        buf += n;
+        len -= n;
+    }
+    return (0);
+}
+
+/**
+ * packRequest - Serializes what the zygote needs to run info->path.
+ * @info: The parameter struct.
+ * @req: Filled in with the counts and the size of the packed strings.
+ *
+ * Description: The strings are the path, the cwd, then argv and the
+ * exported environment, each NUL-terminated.
+ *
+ * Return: The allocated buffer, or NULL on failure.
+ */
+char *packRequest(shell_info *info, zygote_req_t *req)
+{
+    char cwd[PATH_MAX], **env = get_environ(info), *buf, *p;
+    int i;
+
+    if (!getcwd(cwd, sizeof(cwd)))
+        return (NULL);
+    req->len = _strlen(info->path) + _strlen(cwd) + 2;
+    for (req->argc = 0; info->argv[req->argc]; req->argc++)
+        req->len += _strlen(info->argv[req->argc]) + 1;
+    for (req->envc = 0; env && env[req->envc]; req->envc++)
+        req->len += _strlen(env[req->envc]) + 1;
+
+    buf = malloc(req->len);
+    if (!buf)
+        return (NULL);
+    p = buf;
+    p = _strcpy(p, info->path) + _strlen(info->path) + 1;
+    p = _strcpy(p, cwd) + _strlen(cwd) + 1;
+    for (i = 0; i < req->argc; i++)
+        p = _strcpy(p, info->argv[i]) + _strlen(info->argv[i]) + 1;
+    for (i = 0; i < req->envc; i++)
+        p = _strcpy(p, env[i]) + _strlen(env[i]) + 1;
+    return (buf);
+}
+
+/**
+ * unpackRequest - Rebuilds argv and envp from a packed request.
+ * @buf: The packed strings.
+ * @req: The request header.
+ * @argv: Set to the allocated argv; envp follows it in the same array.
+ *
+ * Return: Pointer to the cwd string; the path is at buf.
+ */
+char *unpackRequest(char *buf, zygote_req_t *req, char ***argv)
+{
+    char *p = buf, *cwd;
+    int i;
+
+    *argv = malloc(sizeof(char *) * (req->argc + req->envc + 2));
+    if (!*argv)
+        return (NULL);
+    p += _strlen(p) + 1;
+    cwd = p;
+    p += _strlen(p) + 1;
+    for (i = 0; i < req->argc + req->envc + 1; i++)
+    {
+        if (i == req->argc)
+        {
+            (*argv)[i] = NULL;
+            continue;
+        }
+        (*argv)[i] = p;
+        p += _strlen(p) + 1;
+    }
+    (*argv)[i] = NULL;
+    return (cwd);
+}